@@ -4,6 +4,7 @@
    file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 package org.genivi.commonapi.console;
 
+import java.io.File;
 import java.util.ArrayList;
 import java.util.HashMap;
 import java.util.List;
@@ -56,6 +57,7 @@ public enum CommandExecuter
     private final String       OPTION_ARG_NAME_ATTRIBUTE_NAME              = "argName";
     private final String       OPTION_HAS_OPTIONAL_ARG_ATTRIBUTE_NAME      = "hasOptionalArg";
     private final String       OPTION_VALUE_SEPARATOR_ATTRIBUTE_NAME       = "valueSeparator";
+    private final String       OPTION_IS_PATH_ATTRIBUTE_NAME               = "isPath";
 
     private final String       OPTION_ID_OPTION_ID_ATTRIBUTE_NAME          = "optionId";
 
@@ -118,6 +120,9 @@ public enum CommandExecuter
     {
         Assert.isNotNull(arguments);
 
+        // The executer may run several commands (daemon mode)
+        returnValue = DEFAULT_RETURN_VALUE;
+
         final List<ConsoleConfiguration> configurations = getParsedExtensionPointConfigurations();
 
         // Print message if there are no registered console commands.
@@ -250,6 +255,46 @@ public enum CommandExecuter
         return returnValue;
     }
 
+    /**
+     * Returns the options of all console commands, keyed by "-shortName" and "--longName". The type
+     * of options whose argument values are paths (isPath attribute) is File. If commands declare
+     * different options with the same name, an option with paths is preferred.
+     */
+    public Map<String, Option> getOptions()
+    {
+        Map<String, Option> options = new HashMap<String, Option>();
+
+        for (ConsoleConfiguration configuration : getParsedExtensionPointConfigurations())
+        {
+            for (Object object : configuration.options.getOptions())
+            {
+                Option option = (Option) object;
+
+                if (null != option.getOpt())
+                {
+                    putOption(options, "-" + option.getOpt(), option);
+                }
+
+                if (null != option.getLongOpt())
+                {
+                    putOption(options, "--" + option.getLongOpt(), option);
+                }
+            }
+        }
+
+        return options;
+    }
+
+    private void putOption(Map<String, Option> options, String name, Option option)
+    {
+        Option previousOption = options.get(name);
+
+        if (null == previousOption || !File.class.equals(previousOption.getType()))
+        {
+            options.put(name, option);
+        }
+    }
+
     private void printHelp(List<ConsoleConfiguration> configurations)
     {
         for (ConsoleConfiguration configuration : configurations)
@@ -439,6 +484,7 @@ public enum CommandExecuter
         String argName = optionConfiguration.getAttribute(OPTION_ARG_NAME_ATTRIBUTE_NAME);
         String hasOptionalArg = optionConfiguration.getAttribute(OPTION_HAS_OPTIONAL_ARG_ATTRIBUTE_NAME);
         String valueSeparator = optionConfiguration.getAttribute(OPTION_VALUE_SEPARATOR_ATTRIBUTE_NAME);
+        String isPath = optionConfiguration.getAttribute(OPTION_IS_PATH_ATTRIBUTE_NAME);
 
         Option option = new Option(shortName, description);
         option.setRequired(Boolean.parseBoolean(required));
@@ -460,6 +506,11 @@ public enum CommandExecuter
             option.setValueSeparator(valueSeparator.charAt(0));
         }
 
+        if (Boolean.parseBoolean(isPath))
+        {
+            option.setType(File.class);
+        }
+
         return option;
     }
 
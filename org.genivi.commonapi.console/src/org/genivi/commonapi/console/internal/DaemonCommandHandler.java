@@ -0,0 +1,248 @@
+/* Copyright (C) 2020 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+   This Source Code Form is subject to the terms of the Mozilla Public
+   License, v. 2.0. If a copy of the MPL was not distributed with this
+   file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+package org.genivi.commonapi.console.internal;
+
+import java.io.BufferedReader;
+import java.io.File;
+import java.io.IOException;
+import java.io.InputStreamReader;
+import java.io.PrintStream;
+import java.net.InetAddress;
+import java.net.ServerSocket;
+import java.net.Socket;
+import java.net.SocketTimeoutException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.attribute.PosixFilePermissions;
+import java.security.SecureRandom;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Map;
+
+import org.apache.commons.cli.CommandLine;
+import org.apache.commons.cli.Option;
+import org.genivi.commonapi.console.AbstractCommandLineHandler;
+import org.genivi.commonapi.console.CommandExecuter;
+import org.genivi.commonapi.console.ConsoleLogger;
+
+/**
+ * Keeps the code generator running and executes the commands received from clients. This avoids
+ * starting the Java VM and the OSGi framework for each generator call.
+ *
+ * The daemon listens on a loopback socket. The port and an access token are written to the given
+ * state file, which is readable by the current user only. Removing the state file stops the daemon.
+ *
+ * A request consists of the following lines: the access token, the working directory of the client
+ * and the command line arguments (one per line), terminated by an empty line. The outputs of the
+ * command are sent back, followed by a line containing EXIT_PREFIX and the return value.
+ */
+public class DaemonCommandHandler extends AbstractCommandLineHandler
+{
+    public static final String SHORT_DAEMON_OPTION    = "dm";
+    public static final String LONG_DAEMON_OPTION     = "daemon";
+    public static final String EXIT_PREFIX            = "@@exit ";
+
+    private final int          ACCEPT_TIMEOUT_MS      = 1000;
+    private final int          TOKEN_LENGTH           = 16;
+
+    private final String       STARTED_MESSAGE        = "Code generator daemon listens on port %d (state file: %s)";
+    private final String       STOPPED_MESSAGE        = "Code generator daemon stopped";
+    private final String       ERROR_MESSAGE          = "Code generator daemon failed: %s";
+    private final String       RECURSION_MESSAGE      = "A daemon can not be started by a daemon request";
+
+    @Override
+    public int excute(CommandLine parsedArguments)
+    {
+        File stateFile = new File(parsedArguments.getOptionValue(SHORT_DAEMON_OPTION)).getAbsoluteFile();
+
+        try (ServerSocket server = new ServerSocket(0, 0, InetAddress.getLoopbackAddress()))
+        {
+            String token = createToken();
+
+            writeStateFile(stateFile, server.getLocalPort(), token);
+            println(STARTED_MESSAGE, server.getLocalPort(), stateFile.getPath());
+
+            server.setSoTimeout(ACCEPT_TIMEOUT_MS);
+            while (stateFile.exists())
+            {
+                try (Socket client = server.accept())
+                {
+                    serve(client, token);
+                }
+                catch (SocketTimeoutException exception)
+                {
+                    // check whether the state file still exists
+                }
+                catch (IOException exception)
+                {
+                    // the client closed the connection, continue with the next one
+                }
+            }
+        }
+        catch (IOException exception)
+        {
+            println(ERROR_MESSAGE, exception.getMessage());
+            return 1;
+        }
+        finally
+        {
+            stateFile.delete();
+        }
+
+        println(STOPPED_MESSAGE);
+        return 0;
+    }
+
+    private String createToken()
+    {
+        byte[] bytes = new byte[TOKEN_LENGTH];
+        new SecureRandom().nextBytes(bytes);
+
+        StringBuilder token = new StringBuilder();
+        for (byte b : bytes)
+        {
+            token.append(String.format("%02x", b));
+        }
+        return token.toString();
+    }
+
+    private void writeStateFile(File stateFile, int port, String token) throws IOException
+    {
+        stateFile.delete();
+        Files.createFile(stateFile.toPath());
+        try
+        {
+            Files.setPosixFilePermissions(stateFile.toPath(), PosixFilePermissions.fromString("rw-------"));
+        }
+        catch (UnsupportedOperationException exception)
+        {
+            // no POSIX file system (Windows), the file keeps the default permissions
+        }
+        Files.write(stateFile.toPath(), (port + " " + token + "\n").getBytes(StandardCharsets.UTF_8));
+    }
+
+    private void serve(Socket client, String token) throws IOException
+    {
+        BufferedReader reader = new BufferedReader(new InputStreamReader(client.getInputStream(), StandardCharsets.UTF_8));
+        PrintStream output = new PrintStream(client.getOutputStream(), true, StandardCharsets.UTF_8.name());
+
+        if (!token.equals(reader.readLine()))
+        {
+            return;
+        }
+
+        String workingDirectory = reader.readLine();
+        List<String> arguments = new ArrayList<String>();
+        String line;
+        while ((line = reader.readLine()) != null && !line.isEmpty())
+        {
+            arguments.add(line);
+        }
+
+        int returnValue;
+        PrintStream standardOutput = System.out;
+        PrintStream errorOutput = System.err;
+
+        System.setOut(output);
+        System.setErr(output);
+        try
+        {
+            if (arguments.contains("-" + SHORT_DAEMON_OPTION) || arguments.contains("--" + LONG_DAEMON_OPTION))
+            {
+                println(RECURSION_MESSAGE);
+                returnValue = 1;
+            }
+            else
+            {
+                // a previous request may have switched off the log outputs
+                ConsoleLogger.enableLogging(true);
+                ConsoleLogger.enableErrorLogging(true);
+
+                returnValue = CommandExecuter.INSTANCE.executeCommand(resolveArguments(arguments, workingDirectory));
+            }
+        }
+        finally
+        {
+            System.setOut(standardOutput);
+            System.setErr(errorOutput);
+        }
+
+        output.println(EXIT_PREFIX + returnValue);
+        output.flush();
+    }
+
+    /**
+     * The daemon does not share the working directory of the client. Relative input files and the
+     * relative values of all options that take paths (isPath attribute of the options extension
+     * point, e.g. --dest..., --searchpath, --cache, --depfile, --manifest, --profile) are resolved
+     * against the working directory of the client, whether or not they exist yet.
+     */
+    private String[] resolveArguments(List<String> arguments, String workingDirectory)
+    {
+        String[] resolvedArguments = arguments.toArray(new String[arguments.size()]);
+
+        if (workingDirectory == null)
+        {
+            return resolvedArguments;
+        }
+
+        Map<String, Option> options = CommandExecuter.INSTANCE.getOptions();
+
+        for (int i = 0; i < resolvedArguments.length; i++)
+        {
+            String argument = resolvedArguments[i];
+
+            if (!argument.startsWith("-"))
+            {
+                // not the value of an option, thus an input file
+                resolvedArguments[i] = resolvePath(argument, workingDirectory);
+                continue;
+            }
+
+            String name = argument;
+            String value = null;
+            int separator = argument.indexOf('=');
+            if (argument.startsWith("--") && separator > 0)
+            {
+                name = argument.substring(0, separator);
+                value = argument.substring(separator + 1);
+            }
+
+            Option option = options.get(name);
+            if (option == null)
+            {
+                continue;
+            }
+
+            boolean isPath = File.class.equals(option.getType());
+            if (value != null)
+            {
+                if (isPath)
+                {
+                    resolvedArguments[i] = name + "=" + resolvePath(value, workingDirectory);
+                }
+                continue;
+            }
+
+            // skip the values of the option, resolve them if they are paths
+            for (int j = 0; j < option.getArgs() && i + 1 < resolvedArguments.length
+                    && !resolvedArguments[i + 1].startsWith("-"); j++)
+            {
+                i++;
+                if (isPath)
+                {
+                    resolvedArguments[i] = resolvePath(resolvedArguments[i], workingDirectory);
+                }
+            }
+        }
+
+        return resolvedArguments;
+    }
+
+    private String resolvePath(String path, String workingDirectory)
+    {
+        return new File(path).isAbsolute() ? path : new File(workingDirectory, path).getPath();
+    }
+}
@@ -0,0 +1,265 @@
+/* Copyright (C) 2020 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+   This Source Code Form is subject to the terms of the Mozilla Public
+   License, v. 2.0. If a copy of the MPL was not distributed with this
+   file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+package org.genivi.commonapi.core.cli;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.DirectoryNotEmptyException;
+import java.nio.file.FileAlreadyExistsException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardCopyOption;
+import java.security.MessageDigest;
+import java.security.NoSuchAlgorithmException;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+import java.util.TreeMap;
+import java.util.TreeSet;
+
+import org.eclipse.emf.common.util.URI;
+import org.genivi.commonapi.core.generator.FDeployManager;
+import org.genivi.commonapi.core.preferences.PreferenceConstants;
+
+/**
+ * On-disk cache of the generated files of a generator invocation.
+ *
+ * The key is a hash of the contents of all input files and their transitive
+ * imports, the preference values that influence the generated code and the
+ * generator versions. An entry holds the list of generated files (the file
+ * list of the GeneratorFileSystemAccess) and a copy of each file.
+ *
+ * The imports are resolved by the FDeployManager, like in the generator. The
+ * output directories in the key and the paths in the manifest are relative to
+ * the output root, thus an entry can be restored into another build tree.
+ */
+public class BuildCache {
+
+	private static final String MANIFEST_NAME = "manifest";
+	private static final String FILES_DIRECTORY_NAME = "files";
+
+	// preferences that hold an output directory (outputDirDefault, outputDirProxies, ...)
+	private static final String OUTPUT_PREFERENCE_PREFIX = "outputDir";
+
+	// preferences that do not influence the generated code
+	private static final Set<String> IGNORED_PREFERENCES = new HashSet<String>(Arrays.asList(
+			PreferenceConstants.P_LOGOUTPUT, PreferenceConstants.P_JOBS));
+
+	private File directory;
+	private Path outputRoot;
+
+	/**
+	 * @param directory
+	 *            the directory of the cache entries
+	 * @param outputRoot
+	 *            the default output directory of the generator
+	 */
+	public BuildCache(File directory, File outputRoot) {
+		this.directory = directory;
+		this.outputRoot = outputRoot.getAbsoluteFile().toPath().normalize();
+	}
+
+	/**
+	 * Calculate the key for the given input files
+	 *
+	 * @param files
+	 *            the absolute paths of the input files
+	 * @param preferences
+	 *            the preference values used for the generation
+	 * @param versions
+	 *            the versions of the generator components
+	 * @return the key or null if an import could not be resolved
+	 */
+	public String getKey(List<String> files, Map<String, String> preferences, String... versions) {
+		try {
+			MessageDigest digest = MessageDigest.getInstance("SHA-1");
+
+			for (String version : versions) {
+				update(digest, version);
+			}
+			for (Map.Entry<String, String> preference : new TreeMap<String, String>(preferences).entrySet()) {
+				if (IGNORED_PREFERENCES.contains(preference.getKey())) {
+					continue;
+				}
+				String value = preference.getValue();
+				if (preference.getKey().startsWith(OUTPUT_PREFERENCE_PREFIX) && value != null) {
+					value = toRelativePath(value);
+				}
+				update(digest, preference.getKey() + "=" + value);
+			}
+
+			Set<String> visited = new HashSet<String>();
+			for (String file : files) {
+				update(digest, new File(file).getName());
+				Set<String> dependencies = getDependencies(file);
+				if (dependencies == null) {
+					return null;
+				}
+				for (String dependency : dependencies) {
+					if (visited.add(dependency)) {
+						update(digest, new File(dependency).getName());
+						digest.update(Files.readAllBytes(new File(dependency).toPath()));
+					}
+				}
+			}
+			return toHex(digest.digest());
+		} catch (IOException | NoSuchAlgorithmException e) {
+			return null;
+		}
+	}
+
+	/**
+	 * Determine the files the given input file depends on. The models are loaded
+	 * into a private resource set by an FDeployManager, thus the imports are
+	 * resolved like in the generator.
+	 *
+	 * @param file
+	 *            the absolute path of the input file
+	 * @return the canonical paths of the file and of its transitive imports or
+	 *         null if an import could not be resolved
+	 */
+	public static Set<String> getDependencies(String file) {
+		FDeployManager deployManager = new FDeployManager();
+		try {
+			URI uri = URI.createFileURI(file);
+			deployManager.loadModel(uri, uri);
+			Set<String> dependencies = new TreeSet<String>();
+			dependencies.add(new File(file).getCanonicalPath());
+			for (String loadedModel : deployManager.getLoadedModels()) {
+				URI loadedURI = URI.createURI(loadedModel);
+				// files of plugins (e.g. deployment specifications) are covered by the versions
+				if (!loadedURI.isFile()) {
+					continue;
+				}
+				dependencies.add(new File(loadedURI.toFileString()).getCanonicalPath());
+			}
+			for (String dependency : dependencies) {
+				if (!new File(dependency).isFile()) {
+					return null;
+				}
+			}
+			return dependencies;
+		} catch (IOException e) {
+			return null;
+		} finally {
+			// release the models
+			deployManager.setResourceSet(null);
+		}
+	}
+
+	/**
+	 * Copy the files of the cache entry to their locations. Files with unchanged
+	 * contents are not written.
+	 *
+	 * @param key
+	 *            the key of the cache entry
+	 * @return the paths of the generated files below the current output root or
+	 *         null if there is no entry for the key
+	 */
+	public List<String> restore(String key) {
+		File entry = new File(directory, key);
+		File manifest = new File(entry, MANIFEST_NAME);
+		if (!manifest.isFile()) {
+			return null;
+		}
+		try {
+			List<String> storedFiles = Files.readAllLines(manifest.toPath(), StandardCharsets.UTF_8);
+			List<String> generatedFiles = new ArrayList<String>();
+			for (int i = 0; i < storedFiles.size(); i++) {
+				Path source = new File(entry, FILES_DIRECTORY_NAME + "/" + i).toPath();
+				Path target = outputRoot.resolve(storedFiles.get(i)).normalize();
+				generatedFiles.add(target.toString());
+				byte[] contents = Files.readAllBytes(source);
+				if (Files.isRegularFile(target) && Arrays.equals(contents, Files.readAllBytes(target))) {
+					continue;
+				}
+				if (target.getParent() != null) {
+					Files.createDirectories(target.getParent());
+				}
+				Files.write(target, contents);
+			}
+			return generatedFiles;
+		} catch (IOException e) {
+			return null;
+		}
+	}
+
+	/**
+	 * Store the generated files in a new cache entry. The entry is written to a
+	 * temporary directory and renamed afterwards, thus a cache directory may be
+	 * shared by several generator processes.
+	 *
+	 * @param key
+	 *            the key of the cache entry
+	 * @param generatedFiles
+	 *            the paths of the generated files
+	 * @return true if the entry was stored
+	 */
+	public boolean store(String key, Iterable<String> generatedFiles) {
+		File entry = new File(directory, key);
+		if (entry.exists()) {
+			return true;
+		}
+		File temporaryEntry = new File(directory, key + "." + System.nanoTime() + ".tmp");
+		try {
+			Files.createDirectories(new File(temporaryEntry, FILES_DIRECTORY_NAME).toPath());
+			List<String> storedFiles = new ArrayList<String>();
+			for (String generatedFile : generatedFiles) {
+				Path source = new File(generatedFile).toPath();
+				// files without contents are not written by the generator
+				if (!Files.isRegularFile(source)) {
+					continue;
+				}
+				Files.copy(source, new File(temporaryEntry, FILES_DIRECTORY_NAME + "/" + storedFiles.size()).toPath());
+				storedFiles.add(toRelativePath(generatedFile));
+			}
+			Files.write(new File(temporaryEntry, MANIFEST_NAME).toPath(), storedFiles, StandardCharsets.UTF_8);
+			Files.move(temporaryEntry.toPath(), entry.toPath(), StandardCopyOption.ATOMIC_MOVE);
+			return true;
+		} catch (DirectoryNotEmptyException | FileAlreadyExistsException e) {
+			// another process stored the same entry
+			delete(temporaryEntry);
+			return entry.exists();
+		} catch (IOException e) {
+			delete(temporaryEntry);
+			return false;
+		}
+	}
+
+	/**
+	 * @return the path relative to the output root, with "/" as separator
+	 */
+	private String toRelativePath(String path) {
+		Path relativePath = outputRoot.relativize(new File(path).getAbsoluteFile().toPath().normalize());
+		return relativePath.toString().replace(File.separatorChar, '/');
+	}
+
+	private void delete(File file) {
+		File[] children = file.listFiles();
+		if (children != null) {
+			for (File child : children) {
+				delete(child);
+			}
+		}
+		file.delete();
+	}
+
+	private static void update(MessageDigest digest, String value) {
+		digest.update(value.getBytes(StandardCharsets.UTF_8));
+		digest.update((byte) 0);
+	}
+
+	private static String toHex(byte[] bytes) {
+		StringBuilder hex = new StringBuilder();
+		for (byte b : bytes) {
+			hex.append(String.format("%02x", b));
+		}
+		return hex.toString();
+	}
+}
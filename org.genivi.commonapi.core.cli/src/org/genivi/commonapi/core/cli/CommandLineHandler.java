@@ -146,6 +146,54 @@ public class CommandLineHandler extends AbstractCommandLineHandler implements
 				if(parsedArguments.hasOption("nsc")) {
 					cliTool.disableSyncCalls();
 				}
+				// Generate forward declaration headers and include less
+				if(parsedArguments.hasOption("lh")) {
+					cliTool.enableLeanHeaders();
+				}
+				// Declare the default proxy as extern template and instantiate it in XxxProxy.cpp
+				if(parsedArguments.hasOption("ep")) {
+					cliTool.enableExternProxyTemplates();
+				}
+				// Generate <package>_unity.cpp and <package>_pch.hpp per package
+				if(parsedArguments.hasOption("ub")) {
+					cliTool.enableUnityBuild();
+				}
+				// Generate compile-time metadata tables into the interface headers
+				if(parsedArguments.hasOption("im")) {
+					cliTool.enableInterfaceMetadata();
+				}
+				// Generate serializedSize() for structs, unions, arrays and maps
+				if(parsedArguments.hasOption("ss")) {
+					cliTool.enableSerializedSize();
+				}
+				// Generate ...Data structs with a memcpy fast path for structs with a packed layout
+				if(parsedArguments.hasOption("ts")) {
+					cliTool.enableTrivialStructs();
+				}
+				// Generate std::pmr containers and allocator-aware structs
+				if(parsedArguments.hasOption("pm")) {
+					cliTool.enablePmrTypes();
+				}
+				// -ca --cache directory of the build cache
+				if(parsedArguments.hasOption("ca")) {
+					cliTool.setBuildCacheDirectory(parsedArguments.getOptionValue("ca"));
+				}
+				// -df --depfile depfile of the generated files
+				if(parsedArguments.hasOption("df")) {
+					cliTool.setDepFile(parsedArguments.getOptionValue("df"));
+				}
+				// -mf --manifest manifest of the generated files
+				if(parsedArguments.hasOption("mf")) {
+					cliTool.setManifestFile(parsedArguments.getOptionValue("mf"));
+				}
+				// -pr --profile report of the time and memory per phase and artifact
+				if(parsedArguments.hasOption("pr")) {
+					cliTool.setProfileFile(parsedArguments.getOptionValue("pr"));
+				}
+				// -j --jobs number of threads that render the generated files
+				if(parsedArguments.hasOption("j")) {
+					cliTool.setJobs(parsedArguments.getOptionValue("j"));
+				}
 				// print out generated files
 				if(parsedArguments.hasOption("pf")) {
 					cliTool.listGeneratedFiles();
@@ -5,13 +5,19 @@
 package org.genivi.commonapi.core.cli;
 
 import java.io.File;
+import java.io.IOException;
 import java.util.ArrayList;
+import java.util.HashMap;
 import java.util.List;
+import java.util.Map;
+import java.util.Set;
+import java.util.TreeSet;
 
 import org.eclipse.emf.common.util.URI;
 import org.eclipse.emf.ecore.EObject;
 import org.eclipse.emf.ecore.EStructuralFeature;
 import org.eclipse.emf.ecore.resource.Resource;
+import org.eclipse.emf.ecore.resource.ResourceSet;
 import org.eclipse.xtext.generator.IGenerator;
 import org.eclipse.xtext.resource.XtextResourceSet;
 import org.eclipse.xtext.validation.AbstractValidationMessageAcceptor;
@@ -21,9 +27,11 @@ import org.franca.core.franca.FModel;
 import org.franca.deploymodel.dsl.fDeploy.FDModel;
 import org.genivi.commonapi.console.CommandlineTool;
 import org.genivi.commonapi.console.ConsoleLogger;
+import org.genivi.commonapi.core.generator.FDeployManager;
 import org.genivi.commonapi.core.generator.FrancaGenerator;
 import org.genivi.commonapi.core.generator.FrancaGeneratorExtensions;
 import org.genivi.commonapi.core.generator.GeneratorFileSystemAccess;
+import org.genivi.commonapi.core.generator.GeneratorProfiler;
 import org.genivi.commonapi.core.preferences.FPreferences;
 import org.genivi.commonapi.core.preferences.PreferenceConstants;
 import org.genivi.commonapi.core.verification.CommandlineValidator;
@@ -45,6 +53,17 @@ public class CommandlineToolMain extends CommandlineTool {
 	protected IGenerator francaGenerator;
 	protected String scope = "Core validation: ";
 	private ValidateElements validateElements = new ValidateElements();
+	private String buildCacheDirectory = null;
+	private String depFile = null;
+	private String manifestFile = null;
+	private String profileFile = null;
+
+	private static final int PROFILE_SUMMARY_COUNT = 10;
+
+	// Shared by all command line tools of the process. In daemon mode, a tool is created
+	// for each request, but the Xtext setup and the generator are kept warm.
+	private static Injector sharedInjector = null;
+	private static FrancaGenerator sharedGenerator = null;
 
 	private ValidationMessageAcceptor cliMessageAcceptor = new AbstractValidationMessageAcceptor() {
 
@@ -76,20 +95,44 @@ public class CommandlineToolMain extends CommandlineTool {
 	 */
 	public CommandlineToolMain() {
 
-		injector = Guice.createInjector(new FrancaIDLRuntimeModule());
+		injector = getSharedInjector();
 
 		fsa = injector.getInstance(GeneratorFileSystemAccess.class);
 
 		pref = FPreferences.getInstance();
+		// start with the defaults, a previous command in the same process (daemon mode)
+		// may have changed the preferences
+		pref.resetPreferences();
 
 	}
 
 	public int generateCore(List<String> fileList) {
-		francaGenerator = injector.getInstance(FrancaGenerator.class);
+		francaGenerator = getSharedGenerator();
 
 		return doGenerate(fileList);
 	}
 
+	/**
+	 * @return the injector of the process, it is created by the first command line tool
+	 */
+	protected static synchronized Injector getSharedInjector() {
+		if (sharedInjector == null) {
+			sharedInjector = Guice.createInjector(new FrancaIDLRuntimeModule());
+		}
+		return sharedInjector;
+	}
+
+	/**
+	 * @return the generator of the process. Its state of a generation is reset by
+	 *         startInvocation and released by finishInvocation.
+	 */
+	private static synchronized FrancaGenerator getSharedGenerator() {
+		if (sharedGenerator == null) {
+			sharedGenerator = getSharedInjector().getInstance(FrancaGenerator.class);
+		}
+		return sharedGenerator;
+	}
+
 	protected String normalize(String _path) {
 		File itsFile = new File(_path);
 		return itsFile.getAbsolutePath();
@@ -121,11 +164,70 @@ public class CommandlineToolMain extends CommandlineTool {
 			fileList.add(absolutePath);
 		}
 
+		// skip the generation if the build cache contains the outputs for the same inputs
+		BuildCache buildCache = null;
+		String buildCacheKey = null;
+		if (buildCacheDirectory != null && isCodeGeneration) {
+			buildCache = new BuildCache(new File(buildCacheDirectory), new File(FPreferences.getInstance()
+					.getPreference(PreferenceConstants.P_OUTPUT_DEFAULT, PreferenceConstants.DEFAULT_OUTPUT)));
+			buildCacheKey = buildCache.getKey(fileList, pref.getPreferences(),
+					FrancaGeneratorExtensions.getCoreVersion(), getFrancaVersion());
+			List<String> restoredFiles = (buildCacheKey != null ? buildCache.restore(buildCacheKey) : null);
+			if (restoredFiles != null) {
+				ConsoleLogger.printLog("Build cache hit " + buildCacheKey + ": restored "
+						+ restoredFiles.size() + " files");
+				// the restored files are not assigned to the single input files
+				GenerationReport report = new GenerationReport();
+				for (String file : fileList) {
+					Set<String> dependencies = BuildCache.getDependencies(file);
+					report.addInput(file, dependencies != null ? dependencies : new TreeSet<String>(),
+							restoredFiles);
+				}
+				writeReport(report);
+				if (dumpGeneratedFiles) {
+					for (String restoredFile : restoredFiles) {
+						System.out.println(restoredFile);
+					}
+				}
+				dumpGeneratedFiles = false;
+				return error_state;
+			}
+		}
+
+		// generate models that are shared by several files only once
+		if (francaGenerator instanceof FrancaGenerator) {
+			((FrancaGenerator) francaGenerator).startInvocation();
+		}
+		long startTime = System.currentTimeMillis();
+		GenerationReport report = new GenerationReport();
+		if (profileFile != null) {
+			GeneratorProfiler.clear();
+			GeneratorProfiler.enable(true);
+		}
+
+		// The resource set is shared by all files. Resources that were loaded
+		// before (e.g. as an import of another file) are reused unless their
+		// contents changed.
+		Map<String, String> contentHashes = new HashMap<String, String>();
 		for (String file : fileList) {
+			GeneratorProfiler.setCurrentFile(file);
 			URI uri = URI.createFileURI(file);
 			Resource resource = null;
 			try {
-				resource = rsset.createResource(uri);
+				String contentHash = FDeployManager.getContentHash(rsset.getURIConverter(), uri);
+				resource = rsset.getResource(uri, false);
+				if (resource != null && contentHashes.containsKey(uri.toString())
+						&& (contentHash == null || !contentHash.equals(contentHashes.get(uri.toString())))) {
+					// A resource with the same URI can not be created twice,
+					// remove the outdated one from the resource set
+					resource.unload();
+					rsset.getResources().remove(resource);
+					resource = null;
+				}
+				if (resource == null) {
+					resource = rsset.createResource(uri);
+				}
+				contentHashes.put(uri.toString(), contentHash);
 			} catch (IllegalStateException ise) {
 				ConsoleLogger.printErrorLog("Failed to create a resource from "
 						+ file + "\n" + ise.getMessage());
@@ -134,7 +236,7 @@ public class CommandlineToolMain extends CommandlineTool {
 			}
 			hasValidationError = false;
 			if (isValidation) {
-				validateCore(resource);
+				validateCore(resource, rsset);
 			}
 			if (hasValidationError) {
 				ConsoleLogger.printErrorLog(file
@@ -151,20 +253,45 @@ public class CommandlineToolMain extends CommandlineTool {
 						fsa.setOutputConfigurations(FPreferences.getInstance()
 								.getOutputpathConfiguration(subdir));
 					}
+					fsa.startRecording();
 					francaGenerator.doGenerate(resource, fsa);
+					report.addInput(file, getDependencies(file), fsa.getRecordedFileList());
 				} catch (Exception e) {
 					System.err.println("Failed to generate code for " + file
 							+ " due to " + e.getMessage());
 					error_state = ERROR_STATE;
 				}
 			}
-			if (resource != null) {
-				// Clear each resource from the resource set in order to let
-				// other fidl files import it.
-				// Otherwise an IllegalStateException will be thrown for a
-				// resource that was already created.
-				resource.unload();
-				rsset.getResources().clear();
+		}
+		// Release the models of this invocation
+		for (Resource resource : rsset.getResources()) {
+			resource.unload();
+		}
+		rsset.getResources().clear();
+		if (francaGenerator instanceof FrancaGenerator) {
+			((FrancaGenerator) francaGenerator).finishInvocation();
+		}
+		if (isCodeGeneration) {
+			ConsoleLogger.printLog("Written " + fsa.getWrittenCount() + " files, skipped "
+					+ fsa.getSkippedCount() + " unchanged files in "
+					+ (System.currentTimeMillis() - startTime) + " ms");
+			writeReport(report);
+		}
+		if (profileFile != null) {
+			GeneratorProfiler.enable(false);
+			ProfileReport profileReport = new ProfileReport(GeneratorProfiler.getMeasurements());
+			profileReport.printSummary(PROFILE_SUMMARY_COUNT);
+			try {
+				profileReport.writeReport(new File(profileFile));
+			} catch (IOException e) {
+				ConsoleLogger.printErrorLog("Failed to write the profile " + profileFile + ": " + e.getMessage());
+			}
+			GeneratorProfiler.clear();
+		}
+		if (buildCacheKey != null && error_state == NO_ERROR_STATE) {
+			if (!buildCache.store(buildCacheKey, fsa.getFileList())) {
+				ConsoleLogger.printErrorLog("Failed to store the generated files in the build cache "
+						+ buildCacheDirectory);
 			}
 		}
 		if (dumpGeneratedFiles) {
@@ -175,20 +302,68 @@ public class CommandlineToolMain extends CommandlineTool {
 		return error_state;
 	}
 
+	/**
+	 * @return the local files loaded for the last generated input file
+	 */
+	private Set<String> getDependencies(String file) {
+		Set<String> dependencies = new TreeSet<String>();
+		dependencies.add(file);
+		if (francaGenerator instanceof FrancaGenerator) {
+			for (String loadedModel : ((FrancaGenerator) francaGenerator).getLoadedModels()) {
+				URI uri = URI.createURI(loadedModel);
+				if (uri.isFile()) {
+					dependencies.add(uri.toFileString());
+				}
+			}
+		}
+		return dependencies;
+	}
+
+	private void writeReport(GenerationReport report) {
+		if (depFile != null) {
+			try {
+				report.writeDepfile(new File(depFile));
+			} catch (IOException e) {
+				ConsoleLogger.printErrorLog("Failed to write the depfile " + depFile + ": " + e.getMessage());
+			}
+		}
+		if (manifestFile != null) {
+			try {
+				report.writeManifest(new File(manifestFile));
+			} catch (IOException e) {
+				ConsoleLogger.printErrorLog("Failed to write the manifest " + manifestFile + ": " + e.getMessage());
+			}
+		}
+	}
+
 	/**
 	 * Validate the fidl/fdepl file resource
 	 *
 	 * @param resource
+	 * @param resourceSet the resource set to load the imports into
 	 */
-	private void validateCore(Resource resource) {
+	private void validateCore(Resource resource, ResourceSet resourceSet) {
 		EObject model = null;
 		CommandlineValidator cliValidator = new CommandlineValidator(
-				cliMessageAcceptor);
+				cliMessageAcceptor, resourceSet);
 
 		//ConsoleLogger.printLog("validating " + resource.getURI().lastSegment());
 
+		GeneratorProfiler.Measurement parsingMeasurement = GeneratorProfiler.start(GeneratorProfiler.PHASE,
+				GeneratorProfiler.PARSING);
 		model = cliValidator.loadResource(resource);
+		GeneratorProfiler.stop(parsingMeasurement);
+
+		GeneratorProfiler.Measurement validationMeasurement = GeneratorProfiler.start(GeneratorProfiler.PHASE,
+				GeneratorProfiler.VALIDATION);
+		try {
+			validateModel(model, resource, cliValidator);
+		} finally {
+			GeneratorProfiler.stop(validationMeasurement);
+		}
+	}
 
+	private void validateModel(EObject model, Resource resource, CommandlineValidator cliValidator) {
 		if (model != null) {
 			// check existence of imported fidl/fdepl files
 			if (model instanceof FModel) {
@@ -350,4 +525,104 @@ public class CommandlineToolMain extends CommandlineTool {
 		pref.setPreference(PreferenceConstants.P_GENERATE_SYNC_CALLS, "false");
 	}
 
+	public void enableLeanHeaders() {
+		ConsoleLogger.printLog("Forward declaration headers are generated and used for managed stubs");
+		pref.setPreference(PreferenceConstants.P_LEAN_HEADERS, "true");
+	}
+
+	public void enableExternProxyTemplates() {
+		ConsoleLogger.printLog("Default proxies are instantiated in the proxy source files");
+		pref.setPreference(PreferenceConstants.P_EXTERN_PROXY_TEMPLATES, "true");
+	}
+
+	public void enableUnityBuild() {
+		ConsoleLogger.printLog("Unity build files are generated per package");
+		pref.setPreference(PreferenceConstants.P_UNITY_BUILD, "true");
+	}
+
+	public void enableInterfaceMetadata() {
+		ConsoleLogger.printLog("Interface metadata is generated");
+		pref.setPreference(PreferenceConstants.P_INTERFACE_METADATA, "true");
+	}
+
+	public void enableSerializedSize() {
+		ConsoleLogger.printLog("Serialized size functions are generated");
+		pref.setPreference(PreferenceConstants.P_SERIALIZED_SIZE, "true");
+	}
+
+	public void enableTrivialStructs() {
+		ConsoleLogger.printLog("Trivially copyable struct representations are generated");
+		pref.setPreference(PreferenceConstants.P_TRIVIAL_STRUCTS, "true");
+	}
+
+	public void enablePmrTypes() {
+		ConsoleLogger.printLog("std::pmr containers and allocator-aware structs are generated");
+		pref.setPreference(PreferenceConstants.P_PMR_TYPES, "true");
+	}
+
+	/**
+	 * Set the directory of the build cache. If the cache contains the generated
+	 * files for the same inputs and preferences, they are restored instead of
+	 * running the generator.
+	 *
+	 * @param optionValue the cache directory
+	 */
+	public void setBuildCacheDirectory(String optionValue) {
+		buildCacheDirectory = optionValue;
+		ConsoleLogger.printLog("Build cache directory: " + optionValue);
+	}
+
+	/**
+	 * Set the path of the depfile (Make/Ninja syntax) that lists the generated
+	 * files and the input files they depend on. The depfile has a single rule
+	 * with all generated files as outputs, Ninja reads such rules since 1.10.
+	 *
+	 * @param optionValue the path of the depfile
+	 */
+	public void setDepFile(String optionValue) {
+		depFile = optionValue;
+		ConsoleLogger.printLog("Depfile: " + optionValue);
+	}
+
+	/**
+	 * Set the path of the JSON manifest that lists the dependencies and the
+	 * generated files of each input file
+	 *
+	 * @param optionValue the path of the manifest
+	 */
+	public void setManifestFile(String optionValue) {
+		manifestFile = optionValue;
+		ConsoleLogger.printLog("Manifest: " + optionValue);
+	}
+
+	/**
+	 * Set the path of the JSON report of the generator profile. The time and
+	 * the allocated memory are recorded per phase, per input file and per
+	 * generated artifact.
+	 *
+	 * @param optionValue the path of the report
+	 */
+	public void setProfileFile(String optionValue) {
+		profileFile = optionValue;
+		ConsoleLogger.printLog("Profile report: " + optionValue);
+	}
+
+	/**
+	 * Set the number of threads that render the generated files in parallel
+	 *
+	 * @param optionValue the number of threads (at least 1)
+	 */
+	public void setJobs(String optionValue) {
+		try {
+			int jobs = Integer.parseInt(optionValue);
+			if (jobs < 1) {
+				throw new NumberFormatException();
+			}
+			pref.setPreference(PreferenceConstants.P_JOBS, String.valueOf(jobs));
+			ConsoleLogger.printLog("Using " + jobs + " generator threads");
+		} catch (NumberFormatException e) {
+			ConsoleLogger.printErrorLog("Invalid number of jobs: " + optionValue);
+		}
+	}
+
 }
@@ -0,0 +1,144 @@
+/* Copyright (C) 2020 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+   This Source Code Form is subject to the terms of the Mozilla Public
+   License, v. 2.0. If a copy of the MPL was not distributed with this
+   file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+package org.genivi.commonapi.core.cli;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.util.Collection;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.Set;
+import java.util.TreeSet;
+
+/**
+ * Collects the dependencies and the generated files of each input file and
+ * writes them for build systems: as a Make/Ninja depfile and as a JSON manifest.
+ */
+public class GenerationReport {
+
+	private Map<String, Set<String>> dependencies = new LinkedHashMap<String, Set<String>>();
+	private Map<String, Set<String>> outputs = new LinkedHashMap<String, Set<String>>();
+
+	/**
+	 * @param input
+	 *            the input file
+	 * @param inputDependencies
+	 *            the input file and all files it imports (transitively)
+	 * @param inputOutputs
+	 *            the files generated for the input file, including the files
+	 *            of shared models that were generated for a previous input file
+	 */
+	public void addInput(String input, Collection<String> inputDependencies, Collection<String> inputOutputs) {
+		dependencies.put(input, new TreeSet<String>(inputDependencies));
+		outputs.put(input, new TreeSet<String>(inputOutputs));
+	}
+
+	/**
+	 * Write a depfile with a single rule: all generated files depend on all
+	 * input files and their imports. Ninja accepts depfiles with multiple
+	 * outputs since version 1.10.
+	 */
+	public void writeDepfile(File file) throws IOException {
+		Set<String> allOutputs = new TreeSet<String>();
+		Set<String> allDependencies = new TreeSet<String>();
+		for (String input : dependencies.keySet()) {
+			allOutputs.addAll(outputs.get(input));
+			allDependencies.addAll(dependencies.get(input));
+		}
+
+		StringBuilder depfile = new StringBuilder();
+		for (String output : allOutputs) {
+			if (depfile.length() > 0) {
+				depfile.append(" \\\n");
+			}
+			depfile.append(escapeDepfile(output));
+		}
+		depfile.append(":");
+		for (String dependency : allDependencies) {
+			depfile.append(" \\\n  ").append(escapeDepfile(dependency));
+		}
+		depfile.append("\n");
+
+		write(file, depfile.toString());
+	}
+
+	/**
+	 * Write a JSON manifest that lists the dependencies and the generated files
+	 * of each input file.
+	 */
+	public void writeManifest(File file) throws IOException {
+		StringBuilder manifest = new StringBuilder();
+		manifest.append("{\n  \"inputs\": [");
+		for (Iterator<String> it = dependencies.keySet().iterator(); it.hasNext();) {
+			String input = it.next();
+			manifest.append("\n    {\n");
+			manifest.append("      \"file\": ").append(escapeJson(input)).append(",\n");
+			manifest.append("      \"dependencies\": ");
+			appendJsonArray(manifest, dependencies.get(input));
+			manifest.append(",\n      \"outputs\": ");
+			appendJsonArray(manifest, outputs.get(input));
+			manifest.append("\n    }");
+			if (it.hasNext()) {
+				manifest.append(",");
+			}
+		}
+		manifest.append("\n  ]\n}\n");
+
+		write(file, manifest.toString());
+	}
+
+	private void appendJsonArray(StringBuilder builder, Collection<String> values) {
+		builder.append("[");
+		for (Iterator<String> it = values.iterator(); it.hasNext();) {
+			builder.append("\n        ").append(escapeJson(it.next()));
+			if (it.hasNext()) {
+				builder.append(",");
+			}
+		}
+		builder.append(values.isEmpty() ? "]" : "\n      ]");
+	}
+
+	private static String escapeDepfile(String path) {
+		return path.replace(" ", "\\ ").replace("#", "\\#").replace("$", "$$");
+	}
+
+	static String escapeJson(String value) {
+		StringBuilder escaped = new StringBuilder("\"");
+		for (char c : value.toCharArray()) {
+			switch (c) {
+			case '"':
+				escaped.append("\\\"");
+				break;
+			case '\\':
+				escaped.append("\\\\");
+				break;
+			case '\n':
+				escaped.append("\\n");
+				break;
+			case '\t':
+				escaped.append("\\t");
+				break;
+			default:
+				if (c < 0x20) {
+					escaped.append(String.format("\\u%04x", (int) c));
+				} else {
+					escaped.append(c);
+				}
+			}
+		}
+		return escaped.append("\"").toString();
+	}
+
+	private static void write(File file, String contents) throws IOException {
+		File parent = file.getAbsoluteFile().getParentFile();
+		if (parent != null) {
+			Files.createDirectories(parent.toPath());
+		}
+		Files.write(file.toPath(), contents.getBytes(StandardCharsets.UTF_8));
+	}
+}
@@ -0,0 +1,148 @@
+/* Copyright (C) 2020 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+   This Source Code Form is subject to the terms of the Mozilla Public
+   License, v. 2.0. If a copy of the MPL was not distributed with this
+   file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+package org.genivi.commonapi.core.cli;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.Comparator;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Locale;
+import java.util.Map;
+
+import org.genivi.commonapi.console.ConsoleLogger;
+import org.genivi.commonapi.core.generator.GeneratorProfiler;
+import org.genivi.commonapi.core.generator.GeneratorProfiler.Measurement;
+
+/**
+ * Writes the measurements of the GeneratorProfiler as JSON report and prints
+ * a summary of the most expensive phases and artifacts.
+ */
+public class ProfileReport {
+
+	private List<Measurement> measurements;
+
+	public ProfileReport(List<Measurement> measurements) {
+		this.measurements = measurements;
+	}
+
+	/**
+	 * Write the JSON report: all measurements and their totals per phase, per
+	 * artifact kind and per input file.
+	 */
+	public void writeReport(File file) throws IOException {
+		StringBuilder report = new StringBuilder();
+		report.append("{\n  \"phases\": ");
+		appendTotals(report, getTotals(GeneratorProfiler.PHASE, false));
+		report.append(",\n  \"artifacts\": ");
+		appendTotals(report, getTotals(GeneratorProfiler.ARTIFACT, false));
+		report.append(",\n  \"files\": ");
+		appendTotals(report, getTotals(GeneratorProfiler.PHASE, true));
+		report.append(",\n  \"measurements\": [");
+		for (Iterator<Measurement> it = measurements.iterator(); it.hasNext();) {
+			Measurement measurement = it.next();
+			report.append("\n    { \"category\": ").append(GenerationReport.escapeJson(measurement.getCategory()));
+			report.append(", \"name\": ").append(GenerationReport.escapeJson(measurement.getName()));
+			if (measurement.getSubject() != null) {
+				report.append(", \"subject\": ").append(GenerationReport.escapeJson(measurement.getSubject()));
+			}
+			if (measurement.getFile() != null) {
+				report.append(", \"file\": ").append(GenerationReport.escapeJson(measurement.getFile()));
+			}
+			report.append(", \"timeMs\": ").append(toMilliseconds(measurement.getDuration()));
+			report.append(", \"allocatedBytes\": ").append(measurement.getAllocatedBytes()).append(" }");
+			if (it.hasNext()) {
+				report.append(",");
+			}
+		}
+		report.append("\n  ]\n}\n");
+
+		File parent = file.getAbsoluteFile().getParentFile();
+		if (parent != null) {
+			Files.createDirectories(parent.toPath());
+		}
+		Files.write(file.toPath(), report.toString().getBytes(StandardCharsets.UTF_8));
+	}
+
+	/**
+	 * Print the totals per phase and the most expensive measurements
+	 *
+	 * @param count
+	 *            the number of measurements to print
+	 */
+	public void printSummary(int count) {
+		ConsoleLogger.printLog("Profile (time / allocated memory):");
+		for (Map.Entry<String, long[]> total : getTotals(GeneratorProfiler.PHASE, false).entrySet()) {
+			ConsoleLogger.printLog("  " + total.getKey() + ": " + format(total.getValue()[0], total.getValue()[1]));
+		}
+
+		List<Measurement> sortedMeasurements = new ArrayList<Measurement>(measurements);
+		Collections.sort(sortedMeasurements, new Comparator<Measurement>() {
+			@Override
+			public int compare(Measurement lhs, Measurement rhs) {
+				return Long.compare(rhs.getDuration(), lhs.getDuration());
+			}
+		});
+		ConsoleLogger.printLog("Top " + count + ":");
+		for (Measurement measurement : sortedMeasurements.subList(0, Math.min(count, sortedMeasurements.size()))) {
+			String subject = (measurement.getSubject() != null ? measurement.getSubject()
+					: new File(String.valueOf(measurement.getFile())).getName());
+			ConsoleLogger.printLog("  " + measurement.getName() + " " + subject + ": "
+					+ format(measurement.getDuration(), measurement.getAllocatedBytes()));
+		}
+	}
+
+	/**
+	 * Sum up the time and the allocated memory of the measurements of a
+	 * category, either per name or per input file
+	 */
+	private Map<String, long[]> getTotals(String category, boolean perFile) {
+		Map<String, long[]> totals = new LinkedHashMap<String, long[]>();
+		for (Measurement measurement : measurements) {
+			if (!category.equals(measurement.getCategory())) {
+				continue;
+			}
+			String key = (perFile ? String.valueOf(measurement.getFile()) : measurement.getName());
+			long[] total = totals.get(key);
+			if (total == null) {
+				total = new long[] { 0, 0 };
+				totals.put(key, total);
+			}
+			total[0] += measurement.getDuration();
+			if (total[1] >= 0) {
+				total[1] = (measurement.getAllocatedBytes() >= 0 ? total[1] + measurement.getAllocatedBytes() : -1);
+			}
+		}
+		return totals;
+	}
+
+	private void appendTotals(StringBuilder report, Map<String, long[]> totals) {
+		report.append("{");
+		for (Iterator<Map.Entry<String, long[]>> it = totals.entrySet().iterator(); it.hasNext();) {
+			Map.Entry<String, long[]> total = it.next();
+			report.append("\n    ").append(GenerationReport.escapeJson(total.getKey()));
+			report.append(": { \"timeMs\": ").append(toMilliseconds(total.getValue()[0]));
+			report.append(", \"allocatedBytes\": ").append(total.getValue()[1]).append(" }");
+			if (it.hasNext()) {
+				report.append(",");
+			}
+		}
+		report.append(totals.isEmpty() ? "}" : "\n  }");
+	}
+
+	private static String toMilliseconds(long nanoseconds) {
+		return String.format(Locale.ROOT, "%.3f", nanoseconds / 1000000.0);
+	}
+
+	private static String format(long nanoseconds, long allocatedBytes) {
+		return toMilliseconds(nanoseconds) + " ms"
+				+ (allocatedBytes >= 0 ? " / " + (allocatedBytes / 1024) + " KiB" : "");
+	}
+}
@@ -0,0 +1,114 @@
+# Copyright (C) 2020 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+# This Source Code Form is subject to the terms of the Mozilla Public
+# License, v. 2.0. If a copy of the MPL was not distributed with this
+# file, You can obtain one at http://mozilla.org/MPL/2.0/.
+#
+# Measures the code generator on synthetic models:
+#
+# types:     a type collection with many types. Each struct references types
+#            that are declared after it, thus the generator has to reorder all
+#            types, and the references form a deeply nested graph.
+# polymorph: ti_advanced_polymorph.fidl copied COPY_COUNT times into different
+#            packages, all files are generated by a single generator call.
+#
+# If COMMONAPI_TOOL_GENERATOR_BASELINE is given, that generator is measured as
+# well, e.g. to compare with a previous release. The durations and their ratio
+# are recorded in <BENCHMARK_DIR>/result.txt.
+#
+# Usage:
+#   cmake -DCOMMONAPI_TOOL_GENERATOR=<generator> [-DCOMMONAPI_TOOL_GENERATOR_BASELINE=<generator>]
+#         [-DBENCHMARK=types|polymorph] [-DTYPE_COUNT=5000] [-DCOPY_COUNT=100]
+#         [-DBENCHMARK_DIR=<dir>] -P GeneratorBenchmark.cmake
+
+if(NOT COMMONAPI_TOOL_GENERATOR)
+    message(FATAL_ERROR "Please specify the generator with -DCOMMONAPI_TOOL_GENERATOR=")
+endif()
+if(NOT BENCHMARK)
+    set(BENCHMARK types)
+endif()
+if(NOT TYPE_COUNT)
+    set(TYPE_COUNT 5000)
+endif()
+if(NOT COPY_COUNT)
+    set(COPY_COUNT 100)
+endif()
+if(NOT BENCHMARK_DIR)
+    set(BENCHMARK_DIR "${CMAKE_CURRENT_BINARY_DIR}/generator-benchmark")
+endif()
+
+function(measure_generator GENERATOR NAME RESULT)
+    file(REMOVE_RECURSE "${BENCHMARK_DIR}/src-gen")
+
+    string(TIMESTAMP START_TIME "%s")
+    execute_process(COMMAND ${GENERATOR} --dest "${BENCHMARK_DIR}/src-gen" ${FIDL_FILES}
+                    RESULT_VARIABLE GENERATOR_RESULT
+                    OUTPUT_QUIET)
+    string(TIMESTAMP END_TIME "%s")
+
+    if(NOT GENERATOR_RESULT EQUAL 0)
+        message(FATAL_ERROR "The ${NAME} generator failed (${GENERATOR_RESULT})")
+    endif()
+
+    math(EXPR DURATION "${END_TIME} - ${START_TIME}")
+    message("${NAME}: generated ${MODEL_DESCRIPTION} in ${DURATION} s")
+    file(APPEND "${BENCHMARK_DIR}/result.txt" "${NAME}: ${MODEL_DESCRIPTION}: ${DURATION} s\n")
+    set(${RESULT} ${DURATION} PARENT_SCOPE)
+endfunction()
+
+file(REMOVE_RECURSE "${BENCHMARK_DIR}")
+
+if(BENCHMARK STREQUAL "polymorph")
+    file(READ "${CMAKE_CURRENT_LIST_DIR}/../fidl/ti_advanced_polymorph.fidl" POLYMORPH_FIDL)
+    set(FIDL_FILES)
+    math(EXPR LAST_COPY "${COPY_COUNT} - 1")
+    foreach(COPY RANGE ${LAST_COPY})
+        string(REPLACE "package commonapi.advanced.polymorph" "package commonapi.advanced.polymorph${COPY}"
+               COPY_FIDL "${POLYMORPH_FIDL}")
+        file(WRITE "${BENCHMARK_DIR}/ti_advanced_polymorph${COPY}.fidl" "${COPY_FIDL}")
+        list(APPEND FIDL_FILES "${BENCHMARK_DIR}/ti_advanced_polymorph${COPY}.fidl")
+    endforeach()
+    set(MODEL_DESCRIPTION "${COPY_COUNT} copies of ti_advanced_polymorph.fidl")
+else()
+    # an array and a struct per unit, the references stay within a block of units
+    set(BLOCK_SIZE 20)
+    math(EXPR UNIT_COUNT "${TYPE_COUNT} / 2")
+    math(EXPR LAST_UNIT "${UNIT_COUNT} - 1")
+
+    set(FIDL_FILE "${BENCHMARK_DIR}/GeneratorBenchmark.fidl")
+    file(WRITE "${FIDL_FILE}" "package benchmark\n\ntypeCollection ManyTypes {\n    version { major 1 minor 0 }\n\n")
+
+    foreach(UNIT RANGE ${LAST_UNIT})
+        math(EXPR NEXT "${UNIT} + 1")
+        math(EXPR AFTER_NEXT "${UNIT} + 2")
+        math(EXPR NEXT_IN_BLOCK "${NEXT} % ${BLOCK_SIZE}")
+        math(EXPR AFTER_NEXT_IN_BLOCK "${AFTER_NEXT} % ${BLOCK_SIZE}")
+
+        set(ELEMENTS "        UInt32 value\n")
+        if(NOT NEXT_IN_BLOCK EQUAL 0 AND NEXT LESS UNIT_COUNT)
+            set(ELEMENTS "${ELEMENTS}        Struct${NEXT} next\n")
+            if(NOT AFTER_NEXT_IN_BLOCK EQUAL 0 AND AFTER_NEXT LESS UNIT_COUNT)
+                set(ELEMENTS "${ELEMENTS}        Array${AFTER_NEXT} list\n")
+            endif()
+        endif()
+        file(APPEND "${FIDL_FILE}" "    array Array${UNIT} of Struct${UNIT}\n\n    struct Struct${UNIT} {\n${ELEMENTS}    }\n\n")
+    endforeach()
+
+    file(APPEND "${FIDL_FILE}" "}\n")
+
+    set(FIDL_FILES "${FIDL_FILE}")
+    math(EXPR GENERATED_TYPE_COUNT "${UNIT_COUNT} * 2")
+    set(MODEL_DESCRIPTION "${GENERATED_TYPE_COUNT} types")
+endif()
+
+file(WRITE "${BENCHMARK_DIR}/result.txt" "")
+measure_generator("${COMMONAPI_TOOL_GENERATOR}" "Generator" GENERATOR_DURATION)
+if(COMMONAPI_TOOL_GENERATOR_BASELINE)
+    measure_generator("${COMMONAPI_TOOL_GENERATOR_BASELINE}" "Baseline generator" BASELINE_DURATION)
+    # the durations have a resolution of one second, do not divide by zero
+    if(GENERATOR_DURATION EQUAL 0)
+        set(GENERATOR_DURATION 1)
+    endif()
+    math(EXPR PERCENT "100 * ${BASELINE_DURATION} / ${GENERATOR_DURATION}")
+    message("Baseline generator needs ${PERCENT}% of the time of the generator")
+    file(APPEND "${BENCHMARK_DIR}/result.txt" "Baseline/Generator: ${PERCENT}%\n")
+endif()
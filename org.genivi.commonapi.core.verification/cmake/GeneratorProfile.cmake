@@ -0,0 +1,49 @@
+# Copyright (C) 2020 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+# This Source Code Form is subject to the terms of the Mozilla Public
+# License, v. 2.0. If a copy of the MPL was not distributed with this
+# file, You can obtain one at http://mozilla.org/MPL/2.0/.
+#
+# Generates code with --profile and checks the profile: it must contain
+# measurements, and their allocated memory must not be negative (-1 means
+# that the memory was not measured).
+#
+# Usage:
+#   cmake -DCOMMONAPI_TOOL_GENERATOR=<generator> -DFIDL_FILE=<fidl>
+#         [-DPROFILE_DIR=<dir>] -P GeneratorProfile.cmake
+
+if(NOT COMMONAPI_TOOL_GENERATOR)
+    message(FATAL_ERROR "Please specify the generator with -DCOMMONAPI_TOOL_GENERATOR=")
+endif()
+if(NOT FIDL_FILE)
+    message(FATAL_ERROR "Please specify the model with -DFIDL_FILE=")
+endif()
+if(NOT PROFILE_DIR)
+    set(PROFILE_DIR "${CMAKE_CURRENT_BINARY_DIR}/generator-profile")
+endif()
+
+file(REMOVE_RECURSE "${PROFILE_DIR}")
+set(PROFILE_FILE "${PROFILE_DIR}/profile.json")
+
+execute_process(COMMAND ${COMMONAPI_TOOL_GENERATOR} --dest "${PROFILE_DIR}/src-gen"
+                        --profile "${PROFILE_FILE}" "${FIDL_FILE}"
+                RESULT_VARIABLE GENERATOR_RESULT
+                OUTPUT_QUIET)
+if(NOT GENERATOR_RESULT EQUAL 0)
+    message(FATAL_ERROR "The generator failed (${GENERATOR_RESULT})")
+endif()
+if(NOT EXISTS "${PROFILE_FILE}")
+    message(FATAL_ERROR "The generator did not write the profile ${PROFILE_FILE}")
+endif()
+
+file(READ "${PROFILE_FILE}" PROFILE)
+string(REGEX MATCHALL "\"allocatedBytes\": -?[0-9]+" ALLOCATIONS "${PROFILE}")
+list(LENGTH ALLOCATIONS ALLOCATION_COUNT)
+if(ALLOCATION_COUNT EQUAL 0)
+    message(FATAL_ERROR "The profile ${PROFILE_FILE} contains no measurements")
+endif()
+string(REGEX MATCHALL "\"allocatedBytes\": -[0-9]+" NEGATIVE_ALLOCATIONS "${PROFILE}")
+list(LENGTH NEGATIVE_ALLOCATIONS NEGATIVE_COUNT)
+if(NOT NEGATIVE_COUNT EQUAL 0)
+    message(FATAL_ERROR "${NEGATIVE_COUNT} of ${ALLOCATION_COUNT} allocations in ${PROFILE_FILE} were not measured")
+endif()
+message("${ALLOCATION_COUNT} allocations measured")
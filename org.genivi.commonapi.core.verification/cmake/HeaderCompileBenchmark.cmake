@@ -0,0 +1,63 @@
+# Copyright (C) 2020 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+# This Source Code Form is subject to the terms of the Mozilla Public
+# License, v. 2.0. If a copy of the MPL was not distributed with this
+# file, You can obtain one at http://mozilla.org/MPL/2.0/.
+#
+# Measures the compile time of the generated headers of the verification fidl
+# set, with the default headers and with lean headers (--lean-headers). Each
+# generated header is compiled on its own (syntax check only), as a translation
+# unit that includes just this header.
+#
+# Usage:
+#   cmake -DCOMMONAPI_TOOL_GENERATOR=<generator> -DCXX_COMPILER=<compiler>
+#         -DCOMMONAPI_INCLUDE_DIRS=<include directories> [-DBENCHMARK_DIR=<dir>]
+#         -P HeaderCompileBenchmark.cmake
+
+if(NOT COMMONAPI_TOOL_GENERATOR OR NOT CXX_COMPILER)
+    message(FATAL_ERROR "Please specify -DCOMMONAPI_TOOL_GENERATOR= and -DCXX_COMPILER=")
+endif()
+if(NOT BENCHMARK_DIR)
+    set(BENCHMARK_DIR "${CMAKE_CURRENT_BINARY_DIR}/header-compile-benchmark")
+endif()
+
+file(GLOB FIDL_FILES "${CMAKE_CURRENT_LIST_DIR}/../fidl/*.fidl")
+file(GLOB FDEPL_FILES "${CMAKE_CURRENT_LIST_DIR}/../fidl/*.fdepl")
+
+set(INCLUDE_OPTIONS)
+foreach(INCLUDE_DIR ${COMMONAPI_INCLUDE_DIRS})
+    list(APPEND INCLUDE_OPTIONS "-I${INCLUDE_DIR}")
+endforeach()
+
+function(measure_headers MODE)
+    set(SRC_GEN_DIR "${BENCHMARK_DIR}/${MODE}/src-gen")
+    file(REMOVE_RECURSE "${BENCHMARK_DIR}/${MODE}")
+
+    execute_process(COMMAND ${COMMONAPI_TOOL_GENERATOR} --dest ${SRC_GEN_DIR} --skel ${ARGN} ${FIDL_FILES} ${FDEPL_FILES}
+                    RESULT_VARIABLE GENERATOR_RESULT
+                    OUTPUT_QUIET)
+    if(NOT GENERATOR_RESULT EQUAL 0)
+        message(FATAL_ERROR "The generator failed (${GENERATOR_RESULT})")
+    endif()
+
+    file(GLOB_RECURSE HEADERS RELATIVE "${SRC_GEN_DIR}" "${SRC_GEN_DIR}/*.hpp")
+    list(LENGTH HEADERS HEADER_COUNT)
+    set(TRANSLATION_UNIT "${BENCHMARK_DIR}/${MODE}/header.cpp")
+
+    string(TIMESTAMP START_TIME "%s")
+    foreach(HEADER ${HEADERS})
+        file(WRITE "${TRANSLATION_UNIT}" "#include <${HEADER}>\n")
+        execute_process(COMMAND ${CXX_COMPILER} -std=c++11 -fsyntax-only -I${SRC_GEN_DIR} ${INCLUDE_OPTIONS} ${TRANSLATION_UNIT}
+                        RESULT_VARIABLE COMPILER_RESULT
+                        ERROR_VARIABLE COMPILER_ERRORS)
+        if(NOT COMPILER_RESULT EQUAL 0)
+            message(FATAL_ERROR "Failed to compile ${HEADER}:\n${COMPILER_ERRORS}")
+        endif()
+    endforeach()
+    string(TIMESTAMP END_TIME "%s")
+
+    math(EXPR DURATION "${END_TIME} - ${START_TIME}")
+    message("${MODE}: compiled ${HEADER_COUNT} headers in ${DURATION} s")
+endfunction()
+
+measure_headers(default)
+measure_headers(lean --lean-headers)
@@ -0,0 +1,117 @@
+# Copyright (C) 2020 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+# This Source Code Form is subject to the terms of the Mozilla Public
+# License, v. 2.0. If a copy of the MPL was not distributed with this
+# file, You can obtain one at http://mozilla.org/MPL/2.0/.
+#
+# Measures the object code of the default proxies of the verification fidl
+# set, with implicitly instantiated proxies and with extern proxy templates
+# (--extern-proxy-templates). For each proxy, USER_COUNT translation units
+# create the default proxy. All objects (and the generated proxy sources) are
+# linked into a shared library. The script reports the total object size and
+# the link time.
+#
+# Usage:
+#   cmake -DCOMMONAPI_TOOL_GENERATOR=<generator> -DCXX_COMPILER=<compiler>
+#         -DCOMMONAPI_INCLUDE_DIRS=<include directories> [-DUSER_COUNT=20]
+#         [-DBENCHMARK_DIR=<dir>] -P ProxyInstantiationBenchmark.cmake
+
+if(NOT COMMONAPI_TOOL_GENERATOR OR NOT CXX_COMPILER)
+    message(FATAL_ERROR "Please specify -DCOMMONAPI_TOOL_GENERATOR= and -DCXX_COMPILER=")
+endif()
+if(NOT USER_COUNT)
+    set(USER_COUNT 20)
+endif()
+if(NOT BENCHMARK_DIR)
+    set(BENCHMARK_DIR "${CMAKE_CURRENT_BINARY_DIR}/proxy-instantiation-benchmark")
+endif()
+
+file(GLOB FIDL_FILES "${CMAKE_CURRENT_LIST_DIR}/../fidl/*.fidl")
+file(GLOB FDEPL_FILES "${CMAKE_CURRENT_LIST_DIR}/../fidl/*.fdepl")
+
+set(COMPILER_OPTIONS -std=c++11 -O2 -fPIC)
+foreach(INCLUDE_DIR ${COMMONAPI_INCLUDE_DIRS})
+    list(APPEND COMPILER_OPTIONS "-I${INCLUDE_DIR}")
+endforeach()
+
+function(compile SOURCE OBJECT)
+    execute_process(COMMAND ${CXX_COMPILER} ${COMPILER_OPTIONS} -I${SRC_GEN_DIR} -c ${SOURCE} -o ${OBJECT}
+                    RESULT_VARIABLE COMPILER_RESULT
+                    ERROR_VARIABLE COMPILER_ERRORS)
+    if(NOT COMPILER_RESULT EQUAL 0)
+        message(FATAL_ERROR "Failed to compile ${SOURCE}:\n${COMPILER_ERRORS}")
+    endif()
+endfunction()
+
+function(measure_proxies MODE)
+    set(MODE_DIR "${BENCHMARK_DIR}/${MODE}")
+    set(SRC_GEN_DIR "${MODE_DIR}/src-gen")
+    file(REMOVE_RECURSE "${MODE_DIR}")
+
+    execute_process(COMMAND ${COMMONAPI_TOOL_GENERATOR} --dest ${SRC_GEN_DIR} ${ARGN} ${FIDL_FILES} ${FDEPL_FILES}
+                    RESULT_VARIABLE GENERATOR_RESULT
+                    OUTPUT_QUIET)
+    if(NOT GENERATOR_RESULT EQUAL 0)
+        message(FATAL_ERROR "The generator failed (${GENERATOR_RESULT})")
+    endif()
+
+    set(OBJECTS)
+    file(GLOB_RECURSE PROXY_HEADERS RELATIVE "${SRC_GEN_DIR}" "${SRC_GEN_DIR}/*Proxy.hpp")
+    list(LENGTH PROXY_HEADERS PROXY_COUNT)
+    math(EXPR LAST_USER "${USER_COUNT} - 1")
+    foreach(PROXY_HEADER ${PROXY_HEADERS})
+        get_filename_component(PROXY_NAME "${PROXY_HEADER}" NAME_WE)
+
+        # the namespaces the proxy is declared in
+        file(READ "${SRC_GEN_DIR}/${PROXY_HEADER}" PROXY_HEADER_CONTENT)
+        string(FIND "${PROXY_HEADER_CONTENT}" "class ${PROXY_NAME}\n" CLASS_POSITION)
+        string(SUBSTRING "${PROXY_HEADER_CONTENT}" 0 ${CLASS_POSITION} PROXY_HEADER_CONTENT)
+        string(REGEX MATCHALL "namespace [A-Za-z0-9_]+ {" NAMESPACES "${PROXY_HEADER_CONTENT}")
+        string(REPLACE ";" "\n" NAMESPACES_BEGIN "${NAMESPACES}")
+        string(REGEX REPLACE "namespace [A-Za-z0-9_]+ {" "}" NAMESPACES_END "${NAMESPACES}")
+        string(REPLACE ";" "" NAMESPACES_END "${NAMESPACES_END}")
+
+        foreach(USER RANGE ${LAST_USER})
+            set(USER_SOURCE "${MODE_DIR}/${PROXY_NAME}User${USER}.cpp")
+            file(WRITE "${USER_SOURCE}"
+                 "#include <${PROXY_HEADER}>\n\n${NAMESPACES_BEGIN}\n"
+                 "std::shared_ptr<${PROXY_NAME}Default> create${PROXY_NAME}${USER}(std::shared_ptr<CommonAPI::Proxy> _delegate) {\n"
+                 "    return std::make_shared<${PROXY_NAME}Default>(_delegate);\n"
+                 "}\n${NAMESPACES_END}\n")
+            compile("${USER_SOURCE}" "${MODE_DIR}/${PROXY_NAME}User${USER}.o")
+            list(APPEND OBJECTS "${MODE_DIR}/${PROXY_NAME}User${USER}.o")
+        endforeach()
+    endforeach()
+
+    # the explicit instantiations of the default proxies
+    file(GLOB_RECURSE PROXY_SOURCES "${SRC_GEN_DIR}/*Proxy.cpp")
+    foreach(PROXY_SOURCE ${PROXY_SOURCES})
+        get_filename_component(PROXY_NAME "${PROXY_SOURCE}" NAME_WE)
+        compile("${PROXY_SOURCE}" "${MODE_DIR}/${PROXY_NAME}.o")
+        list(APPEND OBJECTS "${MODE_DIR}/${PROXY_NAME}.o")
+    endforeach()
+
+    set(OBJECT_SIZE 0)
+    foreach(OBJECT ${OBJECTS})
+        file(SIZE "${OBJECT}" SIZE)
+        math(EXPR OBJECT_SIZE "${OBJECT_SIZE} + ${SIZE}")
+    endforeach()
+    math(EXPR OBJECT_SIZE_KIB "${OBJECT_SIZE} / 1024")
+
+    string(TIMESTAMP START_TIME "%s")
+    execute_process(COMMAND ${CXX_COMPILER} -shared -o ${MODE_DIR}/libProxyBenchmark.so ${OBJECTS}
+                    RESULT_VARIABLE LINKER_RESULT
+                    ERROR_VARIABLE LINKER_ERRORS)
+    string(TIMESTAMP END_TIME "%s")
+    if(NOT LINKER_RESULT EQUAL 0)
+        message(FATAL_ERROR "Failed to link:\n${LINKER_ERRORS}")
+    endif()
+    file(SIZE "${MODE_DIR}/libProxyBenchmark.so" LIBRARY_SIZE)
+    math(EXPR LIBRARY_SIZE_KIB "${LIBRARY_SIZE} / 1024")
+
+    math(EXPR DURATION "${END_TIME} - ${START_TIME}")
+    message("${MODE}: ${PROXY_COUNT} proxies, objects ${OBJECT_SIZE_KIB} KiB, "
+            "library ${LIBRARY_SIZE_KIB} KiB, linked in ${DURATION} s")
+endfunction()
+
+measure_proxies(default)
+measure_proxies(extern --extern-proxy-templates)
@@ -13,6 +13,9 @@
 #include <thread>
 #include <fstream>
 #include <atomic>
+#include <chrono>
+#include <iostream>
+#include <vector>
 #include <gtest/gtest.h>
 #include "CommonAPI/CommonAPI.hpp"
 #include "v1/commonapi/advanced/bselective/TestInterfaceProxy.hpp"
@@ -104,7 +107,62 @@ protected:
     std::shared_ptr<CommonAPI::Runtime> runtime_;
     std::shared_ptr<AFSelectiveStub> testStub_;
     std::shared_ptr<TestInterfaceProxy<>> testProxy_;
-    std::shared_ptr<TestInterfaceProxy<>> testProxy2_;        
+    std::shared_ptr<TestInterfaceProxy<>> testProxy2_;
+};
+
+/*
+ * Client id that is not bound to a connection. Allows to create a large
+ * number of distinct clients without building proxies.
+ */
+class RegistryClientId: public CommonAPI::ClientId {
+public:
+    RegistryClientId(std::size_t _id) : id_(_id) {}
+    virtual ~RegistryClientId() {}
+
+    virtual bool operator==(CommonAPI::ClientId &_other) {
+        RegistryClientId *other = dynamic_cast<RegistryClientId *>(&_other);
+        return (other != nullptr && other->id_ == id_);
+    }
+    virtual std::size_t hashCode() { return id_; }
+    virtual uid_t getUid() const { return 0; }
+    virtual gid_t getGid() const { return 0; }
+    virtual std::string getEnv() const { return ""; }
+    virtual std::string getHostAddress() const { return ""; }
+
+private:
+    std::size_t id_;
+};
+
+/*
+ * Stub adapter that manages its subscribers by means of the generated
+ * subscriber registry only.
+ */
+class RegistryStubAdapter: public TestInterfaceStubAdapter {
+public:
+    virtual void fireBTestSelectiveSelective(const std::shared_ptr<CommonAPI::ClientId> _client, const uint8_t &_ux) {
+        (void)_client;
+        (void)_ux;
+    }
+    virtual void sendBTestSelectiveSelective(const uint8_t &_ux, const std::shared_ptr<CommonAPI::ClientIdList> _receivers = nullptr) {
+        (void)_ux;
+        (void)_receivers;
+    }
+    virtual void subscribeForbTestSelectiveSelective(const std::shared_ptr<CommonAPI::ClientId> _client, bool &_success) {
+        _success = addSubscriberForBTestSelectiveSelective(_client);
+    }
+    virtual void unsubscribeFrombTestSelectiveSelective(const std::shared_ptr<CommonAPI::ClientId> _client) {
+        (void)removeSubscriberForBTestSelectiveSelective(_client);
+    }
+    virtual std::shared_ptr<CommonAPI::ClientIdList> const getSubscribersForBTestSelectiveSelective() {
+        // the adapter interface hands out a non-const list, the snapshot itself is never modified
+        return std::const_pointer_cast<CommonAPI::ClientIdList>(getSubscriberSnapshotForBTestSelectiveSelective());
+    }
+    virtual void deactivateManagedInstances() {
+    }
+
+    bool isSubscribed(const std::shared_ptr<CommonAPI::ClientId> &_client) {
+        return hasSubscriberForBTestSelectiveSelective(_client);
+    }
 };
 
 /**
@@ -940,6 +998,63 @@ TEST_F(AFSelective, Two_proxies_subscribe_delete_one_proxy_error_listener_test)
      ASSERT_EQ(CommonAPI::CallStatus::SUCCESS, subStatus3);
 }
 
+/**
+* @test Subscribe and unsubscribe a large number of clients.
+*  - subscribe 10000 distinct clients to the subscriber registry
+*  - check that double subscriptions are rejected and membership is found
+*  - take a snapshot of the subscribers and unsubscribe every second client
+*  - check that the snapshot is unchanged while the registry is updated
+*  - unsubscribe all remaining clients and check that the registry is empty
+*/
+TEST_F(AFSelective, SubscribeUnsubscribeManyClients) {
+    const std::size_t numberOfClients = 10000;
+
+    RegistryStubAdapter adapter;
+    std::vector<std::shared_ptr<CommonAPI::ClientId>> clients;
+    for (std::size_t i = 0; i < numberOfClients; i++) {
+        clients.push_back(std::make_shared<RegistryClientId>(i));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (auto client : clients) {
+        bool success = false;
+        adapter.subscribeForbTestSelectiveSelective(client, success);
+        ASSERT_TRUE(success);
+    }
+    auto subscribed = std::chrono::steady_clock::now();
+
+    bool success = true;
+    adapter.subscribeForbTestSelectiveSelective(clients[0], success);
+    EXPECT_FALSE(success);
+    EXPECT_TRUE(adapter.isSubscribed(std::make_shared<RegistryClientId>(numberOfClients - 1)));
+    EXPECT_FALSE(adapter.isSubscribed(std::make_shared<RegistryClientId>(numberOfClients)));
+
+    std::shared_ptr<CommonAPI::ClientIdList> snapshot = adapter.getSubscribersForBTestSelectiveSelective();
+    ASSERT_EQ(numberOfClients, snapshot->size());
+
+    for (std::size_t i = 0; i < numberOfClients; i += 2) {
+        adapter.unsubscribeFrombTestSelectiveSelective(clients[i]);
+    }
+    EXPECT_EQ(numberOfClients, snapshot->size());
+    EXPECT_EQ(numberOfClients / 2, adapter.getSubscribersForBTestSelectiveSelective()->size());
+    EXPECT_FALSE(adapter.isSubscribed(clients[0]));
+    EXPECT_TRUE(adapter.isSubscribed(clients[1]));
+    snapshot.reset();
+
+    auto unsubscribeStart = std::chrono::steady_clock::now();
+    for (std::size_t i = 1; i < numberOfClients; i += 2) {
+        adapter.unsubscribeFrombTestSelectiveSelective(clients[i]);
+    }
+    auto unsubscribed = std::chrono::steady_clock::now();
+    EXPECT_TRUE(adapter.getSubscribersForBTestSelectiveSelective()->empty());
+
+    std::cout << "Subscribed " << numberOfClients << " clients in "
+              << std::chrono::duration_cast<std::chrono::microseconds>(subscribed - start).count()
+              << "us, unsubscribed " << numberOfClients / 2 << " clients in "
+              << std::chrono::duration_cast<std::chrono::microseconds>(unsubscribed - unsubscribeStart).count()
+              << "us" << std::endl;
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     ::testing::AddGlobalTestEnvironment(new Environment());
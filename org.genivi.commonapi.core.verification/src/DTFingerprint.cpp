@@ -0,0 +1,116 @@
+/* Copyright (C) 2020 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/**
+* @file DataTypes
+*/
+
+#include <gtest/gtest.h>
+#include "CommonAPI/CommonAPI.hpp"
+#include "v1/commonapi/datatypes/fingerprint/TestInterface.hpp"
+#include "v1/commonapi/datatypes/fingerprint/peer/TestInterface.hpp"
+#include "v1/commonapi/datatypes/fingerprint/peer/TestInterfaceRenamedTypes.hpp"
+#include "v1/commonapi/datatypes/fingerprint/peer/TestInterfaceReordered.hpp"
+#include "v1/commonapi/datatypes/fingerprint/peer/TestInterfaceChangedType.hpp"
+#include "v1/commonapi/datatypes/fingerprint/peer/TestInterfaceChangedEnum.hpp"
+#include "v1/commonapi/datatypes/fingerprint/peer/TestInterfaceAddedArgument.hpp"
+#include "v1/commonapi/datatypes/fingerprint/TestManager.hpp"
+#include "v1/commonapi/datatypes/fingerprint/peer/TestManagerRenamedManaged.hpp"
+#include "v1/commonapi/datatypes/fingerprint/peer/TestManagerChangedManaged.hpp"
+#include "v1/commonapi/datatypes/fingerprint/TestPolymorphic.hpp"
+#include "v1/commonapi/datatypes/fingerprint/peer/TestPolymorphicRenamedTypes.hpp"
+#include "v1/commonapi/datatypes/fingerprint/peer/TestPolymorphicChangedDerived.hpp"
+
+class Environment: public ::testing::Environment {
+public:
+    virtual ~Environment() {
+    }
+
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+class DTFingerprint: public ::testing::Test {
+
+protected:
+    void SetUp() {
+    }
+
+    void TearDown() {
+    }
+};
+
+/**
+* @test The fingerprint is a compile time constant.
+*/
+TEST_F(DTFingerprint, CompileTimeConstant) {
+
+    static_assert(v1_0::commonapi::datatypes::fingerprint::TestInterface::getInterfaceFingerprint() != 0,
+                  "fingerprint must be available at compile time");
+}
+
+/**
+* @test Interfaces with the same structure have the same fingerprint, independent
+*       of the names of their package, the interface and the types.
+*/
+TEST_F(DTFingerprint, SameStructure) {
+
+    const uint32_t fingerprint = v1_0::commonapi::datatypes::fingerprint::TestInterface::getInterfaceFingerprint();
+
+    EXPECT_EQ(fingerprint, v1_0::commonapi::datatypes::fingerprint::peer::TestInterface::getInterfaceFingerprint());
+    EXPECT_EQ(fingerprint, v1_0::commonapi::datatypes::fingerprint::peer::TestInterfaceRenamedTypes::getInterfaceFingerprint());
+}
+
+/**
+* @test The order of the declarations does not change the fingerprint.
+*/
+TEST_F(DTFingerprint, DeclarationOrder) {
+
+    EXPECT_EQ(v1_0::commonapi::datatypes::fingerprint::TestInterface::getInterfaceFingerprint(),
+              v1_0::commonapi::datatypes::fingerprint::peer::TestInterfaceReordered::getInterfaceFingerprint());
+}
+
+/**
+* @test Structural changes that keep the interface version change the fingerprint.
+*/
+TEST_F(DTFingerprint, ChangedStructure) {
+
+    const uint32_t fingerprint = v1_0::commonapi::datatypes::fingerprint::TestInterface::getInterfaceFingerprint();
+
+    EXPECT_NE(fingerprint, v1_0::commonapi::datatypes::fingerprint::peer::TestInterfaceChangedType::getInterfaceFingerprint());
+    EXPECT_NE(fingerprint, v1_0::commonapi::datatypes::fingerprint::peer::TestInterfaceChangedEnum::getInterfaceFingerprint());
+    EXPECT_NE(fingerprint, v1_0::commonapi::datatypes::fingerprint::peer::TestInterfaceAddedArgument::getInterfaceFingerprint());
+}
+
+/**
+* @test Managed interfaces contribute their structure, not their names.
+*/
+TEST_F(DTFingerprint, ManagedInterfaces) {
+
+    const uint32_t fingerprint = v1_0::commonapi::datatypes::fingerprint::TestManager::getInterfaceFingerprint();
+
+    EXPECT_EQ(fingerprint, v1_0::commonapi::datatypes::fingerprint::peer::TestManagerRenamedManaged::getInterfaceFingerprint());
+    EXPECT_NE(fingerprint, v1_0::commonapi::datatypes::fingerprint::peer::TestManagerChangedManaged::getInterfaceFingerprint());
+}
+
+/**
+* @test A change of a struct derived from a polymorphic struct changes the fingerprint.
+*/
+TEST_F(DTFingerprint, DerivedStructs) {
+
+    const uint32_t fingerprint = v1_0::commonapi::datatypes::fingerprint::TestPolymorphic::getInterfaceFingerprint();
+
+    EXPECT_EQ(fingerprint, v1_0::commonapi::datatypes::fingerprint::peer::TestPolymorphicRenamedTypes::getInterfaceFingerprint());
+    EXPECT_NE(fingerprint, v1_0::commonapi::datatypes::fingerprint::peer::TestPolymorphicChangedDerived::getInterfaceFingerprint());
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    ::testing::AddGlobalTestEnvironment(new Environment());
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,134 @@
+/* Copyright (C) 2020 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/**
+* @file DataTypes
+*/
+
+#include <gtest/gtest.h>
+#include "CommonAPI/CommonAPI.hpp"
+#include "v1/commonapi/datatypes/metadata/TestInterface.hpp"
+
+using namespace v1_0::commonapi::datatypes::metadata;
+
+typedef TestInterfaceMetadata Metadata;
+
+class Environment: public ::testing::Environment {
+public:
+    virtual ~Environment() {
+    }
+
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+class DTMetadata: public ::testing::Test {
+
+protected:
+    void SetUp() {
+    }
+
+    void TearDown() {
+    }
+
+    void checkElement(uint32_t _index, const char *_name, Metadata::ElementKind _kind,
+                      uint32_t _firstArgument, uint32_t _argumentCount) {
+        const Metadata::Element &element = Metadata::ELEMENTS[_index];
+        ASSERT_NE(nullptr, element.name);
+        EXPECT_STREQ(_name, element.name);
+        EXPECT_EQ(_kind, element.kind);
+        EXPECT_EQ(_firstArgument, element.firstArgument);
+        EXPECT_EQ(_argumentCount, element.argumentCount);
+    }
+
+    void checkArgument(uint32_t _index, const char *_name, Metadata::ArgumentDirection _direction,
+                       const char *_typeName) {
+        const Metadata::Argument &argument = Metadata::ARGUMENTS[_index];
+        ASSERT_NE(nullptr, argument.name);
+        EXPECT_STREQ(_name, argument.name);
+        EXPECT_EQ(_direction, argument.direction);
+        ASSERT_NE(nullptr, argument.typeName);
+        EXPECT_STREQ(_typeName, argument.typeName);
+    }
+};
+
+/**
+* @test The counts are compile time constants and the tables are terminated by an empty entry.
+*/
+TEST_F(DTMetadata, Counts) {
+
+    static_assert(Metadata::ELEMENT_COUNT == 6, "one entry per attribute, method, broadcast and constant");
+    static_assert(Metadata::ARGUMENT_COUNT == 8, "one entry per attribute and argument");
+    static_assert(Metadata::ELEMENTS[Metadata::ELEMENT_COUNT].name == nullptr, "terminated element table");
+    static_assert(Metadata::ARGUMENTS[Metadata::ARGUMENT_COUNT].name == nullptr, "terminated argument table");
+
+    EXPECT_EQ(sizeof(Metadata::ELEMENTS) / sizeof(Metadata::Element), Metadata::ELEMENT_COUNT + 1u);
+    EXPECT_EQ(sizeof(Metadata::ARGUMENTS) / sizeof(Metadata::Argument), Metadata::ARGUMENT_COUNT + 1u);
+    EXPECT_STREQ("commonapi.datatypes.metadata.TestInterface:v1_0", Metadata::INTERFACE_NAME);
+}
+
+/**
+* @test The elements are listed in the order of their declaration, with their kind and
+*       the range of their arguments.
+*/
+TEST_F(DTMetadata, Elements) {
+
+    checkElement(0, "aValue", Metadata::KIND_ATTRIBUTE, 0, 1);
+    checkElement(1, "getValues", Metadata::KIND_METHOD, 1, 4);
+    checkElement(2, "notify", Metadata::KIND_FIRE_AND_FORGET_METHOD, 5, 1);
+    checkElement(3, "changed", Metadata::KIND_BROADCAST, 6, 1);
+    checkElement(4, "selected", Metadata::KIND_SELECTIVE_BROADCAST, 7, 1);
+    checkElement(5, "LIMIT", Metadata::KIND_CONSTANT, 8, 0);
+}
+
+/**
+* @test The argument ranges of the elements cover the argument table without gaps.
+*/
+TEST_F(DTMetadata, ArgumentRanges) {
+
+    uint32_t next = 0;
+    for (uint32_t i = 0; i < Metadata::ELEMENT_COUNT; ++i) {
+        EXPECT_EQ(next, Metadata::ELEMENTS[i].firstArgument);
+        next = Metadata::ELEMENTS[i].firstArgument + Metadata::ELEMENTS[i].argumentCount;
+    }
+    EXPECT_EQ(Metadata::ARGUMENT_COUNT, next);
+}
+
+/**
+* @test In-arguments precede out-arguments, attributes and broadcasts only have out-arguments.
+*/
+TEST_F(DTMetadata, Arguments) {
+
+    checkArgument(0, "aValue", Metadata::ARGUMENT_OUT, "UInt32");
+    checkArgument(1, "from", Metadata::ARGUMENT_IN, "UInt32");
+    checkArgument(2, "filter", Metadata::ARGUMENT_IN, "String");
+    checkArgument(3, "values", Metadata::ARGUMENT_OUT, "UInt8[]");
+    checkArgument(4, "more", Metadata::ARGUMENT_OUT, "Boolean");
+    checkArgument(7, "id", Metadata::ARGUMENT_OUT, "UInt16");
+
+    // derived types are given by their fully qualified name
+    checkArgument(5, "kind", Metadata::ARGUMENT_IN, "commonapi.datatypes.metadata.TestInterface.tKind");
+    checkArgument(6, "value", Metadata::ARGUMENT_OUT, "commonapi.datatypes.metadata.TestInterface.tStruct");
+}
+
+/**
+* @test The type id depends on the type signature only.
+*/
+TEST_F(DTMetadata, TypeIds) {
+
+    // UInt32 attribute and UInt32 in-argument
+    EXPECT_EQ(Metadata::ARGUMENTS[0].typeId, Metadata::ARGUMENTS[1].typeId);
+    EXPECT_NE(Metadata::ARGUMENTS[1].typeId, Metadata::ARGUMENTS[2].typeId);
+    EXPECT_NE(Metadata::ARGUMENTS[1].typeId, Metadata::ARGUMENTS[7].typeId);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    ::testing::AddGlobalTestEnvironment(new Environment());
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,178 @@
+/* Copyright (C) 2020 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/**
+* @file DataTypes
+*/
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "CommonAPI/CommonAPI.hpp"
+#include "v1/commonapi/datatypes/size/TestInterface.hpp"
+
+using namespace v1_0::commonapi::datatypes::size;
+
+// A size stream: counts the bytes of the values instead of writing them. Its wire format has no
+// alignment; strings, arrays and maps are preceded by a UInt32 length field and strings end with
+// a terminating zero.
+class CountingOutputStream: public CommonAPI::OutputStream<CountingOutputStream> {
+public:
+    CountingOutputStream()
+        : size_(0) {
+    }
+
+    OutputStream &writeValue(const bool &_value, const CommonAPI::EmptyDeployment *) {
+        return count(sizeof(_value));
+    }
+    OutputStream &writeValue(const uint8_t &_value, const CommonAPI::EmptyDeployment *) {
+        return count(sizeof(_value));
+    }
+    OutputStream &writeValue(const uint16_t &_value, const CommonAPI::EmptyDeployment *) {
+        return count(sizeof(_value));
+    }
+    OutputStream &writeValue(const uint32_t &_value, const CommonAPI::EmptyDeployment *) {
+        return count(sizeof(_value));
+    }
+    OutputStream &writeValue(const double &_value, const CommonAPI::EmptyDeployment *) {
+        return count(sizeof(_value));
+    }
+    OutputStream &writeValue(const std::string &_value, const CommonAPI::EmptyDeployment *) {
+        return count(sizeof(uint32_t) + _value.size() + 1);
+    }
+    template<typename Element_>
+    OutputStream &writeValue(const std::vector<Element_> &_value, const CommonAPI::EmptyDeployment *_depl) {
+        count(sizeof(uint32_t));
+        for (const auto &element : _value)
+            writeValue(element, _depl);
+        return *this;
+    }
+    template<typename Key_, typename Value_, typename Hasher_>
+    OutputStream &writeValue(const std::unordered_map<Key_, Value_, Hasher_> &_value, const CommonAPI::EmptyDeployment *_depl) {
+        count(sizeof(uint32_t));
+        for (const auto &element : _value) {
+            writeValue(element.first, _depl);
+            writeValue(element.second, _depl);
+        }
+        return *this;
+    }
+    template<typename... Types_>
+    OutputStream &writeValue(const CommonAPI::Struct<Types_...> &_value, const CommonAPI::EmptyDeployment *_depl) {
+        writeMembers<0>(_value.values_, _depl);
+        return *this;
+    }
+
+    bool hasError() const {
+        return false;
+    }
+    std::size_t getSize() const {
+        return size_;
+    }
+
+private:
+    OutputStream &count(std::size_t _size) {
+        size_ += _size;
+        return *this;
+    }
+
+    template<std::size_t Index_, typename... Types_>
+    typename std::enable_if<(Index_ < sizeof...(Types_))>::type
+    writeMembers(const std::tuple<Types_...> &_values, const CommonAPI::EmptyDeployment *_depl) {
+        writeValue(std::get<Index_>(_values), _depl);
+        writeMembers<Index_ + 1>(_values, _depl);
+    }
+    template<std::size_t Index_, typename... Types_>
+    typename std::enable_if<(Index_ == sizeof...(Types_))>::type
+    writeMembers(const std::tuple<Types_...> &, const CommonAPI::EmptyDeployment *) {
+    }
+
+    std::size_t size_;
+};
+
+static const CommonAPI::EmptyDeployment *emptyDeployment = nullptr;
+
+class Environment: public ::testing::Environment {
+public:
+    virtual ~Environment() {
+    }
+
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+class DTSerializedSize: public ::testing::Test {
+
+protected:
+    void SetUp() {
+        fixed_ = TestInterface::tFixed(1, 2, true, 3.0);
+    }
+
+    void TearDown() {
+    }
+
+    TestInterface::tFixed fixed_;
+};
+
+/**
+* @test Structs whose members all have a fixed size provide the size of their member values at compile time.
+*/
+TEST_F(DTSerializedSize, PackedSize) {
+
+    static_assert(TestInterface::tFixed::getPackedSize() == 2 + 4 + 1 + 8, "UInt16, UInt32, Boolean and Double");
+    static_assert(TestInterface::tNested::getPackedSize() == 2 * TestInterface::tFixed::getPackedSize(), "two nested structs");
+
+    // the size stream has neither alignment nor length fields for fixed size structs
+    EXPECT_EQ(TestInterface::tFixed::getPackedSize(), fixed_.serializedSize<CountingOutputStream>(emptyDeployment));
+    TestInterface::tNested nested(fixed_, fixed_);
+    EXPECT_EQ(TestInterface::tNested::getPackedSize(), nested.serializedSize<CountingOutputStream>(emptyDeployment));
+}
+
+/**
+* @test The size of a struct with strings and arrays depends on its values.
+*/
+TEST_F(DTSerializedSize, Struct) {
+
+    TestInterface::tVariable variable;
+    const std::size_t emptySize = (4 + 1) + 4 + TestInterface::tFixed::getPackedSize();
+    EXPECT_EQ(emptySize, variable.serializedSize<CountingOutputStream>(emptyDeployment));
+
+    variable.setName("name");
+    variable.setData(std::vector<uint8_t>(10, 0));
+    variable.setFixed(fixed_);
+    EXPECT_EQ(emptySize + 4 + 10, variable.serializedSize<CountingOutputStream>(emptyDeployment));
+}
+
+/**
+* @test Arrays and maps are measured by the serializedSize function of their interface.
+*/
+TEST_F(DTSerializedSize, ArrayAndMap) {
+
+    TestInterface::tFixedArray array;
+    EXPECT_EQ(4u, TestInterface::serializedSize<CountingOutputStream>(array, emptyDeployment));
+    array.push_back(fixed_);
+    array.push_back(fixed_);
+    array.push_back(fixed_);
+    EXPECT_EQ(4 + 3 * TestInterface::tFixed::getPackedSize(),
+              TestInterface::serializedSize<CountingOutputStream>(array, emptyDeployment));
+
+    TestInterface::tNames names;
+    names[1] = "a";
+    names[2] = "bc";
+    EXPECT_EQ(4u + (2 + 4 + 1 + 1) + (2 + 4 + 2 + 1),
+              TestInterface::serializedSize<CountingOutputStream>(names, emptyDeployment));
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    ::testing::AddGlobalTestEnvironment(new Environment());
+    return RUN_ALL_TESTS();
+}
@@ -8,6 +8,9 @@
 */
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
 #include <thread>
 #include "CommonAPI/CommonAPI.hpp"
 
@@ -31,6 +34,23 @@ const int loopCountPerPaylod = 1000;
 
 using namespace v1_0::commonapi::performance::complex;
 
+// Counts the heap allocations of the process (proxy and stub side) to report the
+// allocations and buffer reallocations per call
+static std::atomic<uint64_t> allocationCount(0);
+
+void *operator new(std::size_t _size) {
+    allocationCount++;
+    void *its_memory = std::malloc(_size == 0 ? 1 : _size);
+    if (its_memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return its_memory;
+}
+
+void operator delete(void *_memory) noexcept {
+    std::free(_memory);
+}
+
 class Environment: public ::testing::Environment {
 public:
     virtual ~Environment() {
@@ -89,7 +109,7 @@ protected:
         ASSERT_FALSE(testProxy_->isAvailable());
     }
 
-    void printTestValues(size_t payloadSize, size_t objectSize) {
+    void printTestValues(size_t payloadSize, size_t objectSize, uint64_t allocations) {
         // Get elapsed time, calculate mean time and print out!
         StopWatch::usec_t methodCallTime = watch_.getTotalElapsedMicroseconds();
         StopWatch::usec_t meanTime = (methodCallTime / loopCountPerPaylod);
@@ -101,6 +121,7 @@ protected:
                   << "us, per-Byte(payload)=" << std::setw(7) << std::setfill('.')
                   << (perByteTime <= 0 ? ".....<1" : std::to_string(perByteTime)) << "us"
                   << ", calls/s=" << std::setw(7) << std::setfill('.') << callsPerSeconds
+                  << ", allocs/call=" << std::setw(5) << std::setfill('.') << (allocations / loopCountPerPaylod)
                   << std::endl;
     }
 
@@ -150,15 +171,18 @@ TEST_F(PFComplex, Ping_Pong_Complex_Synchronous) {
                 + sizeof(innerTestStruct.getStringMember()) + sizeof(unionMember);
 
         // Call commonAPI method loopCountPerPaylod times to calculate mean time
+        uint64_t allocations = 0;
         for (uint32_t i = 0; i < loopCountPerPaylod; ++i) {
 
             // Create an empty out-array for every commonAPI function call
             TestInterface::tArray out;
 
-            // Call commonAPI function and measure time
+            // Call commonAPI function and measure time and allocations
+            uint64_t allocationsBefore = allocationCount;
             watch_.start();
             testProxy_->testMethod(in, callStatus, out);
             watch_.stop();
+            allocations += allocationCount - allocationsBefore;
 
             // Check the call was successful & out array has same elements than in array
             EXPECT_EQ(callStatus, CommonAPI::CallStatus::SUCCESS);
@@ -166,7 +190,7 @@ TEST_F(PFComplex, Ping_Pong_Complex_Synchronous) {
         }
 
         // Printing results
-        printTestValues(arraySize_ * payloadSize, arraySize_ * sizeof(testStruct));
+        printTestValues(arraySize_ * payloadSize, arraySize_ * sizeof(testStruct), allocations);
 
         // Increase array size for next iteration
         arraySize_ *= 2;
@@ -213,6 +237,7 @@ TEST_F(PFComplex, Ping_Pong_Complex_Asynchronous) {
         // Only raising for WIN32, since linux should run with the default timeout without problems.
         CommonAPI::CallInfo callInfo(60000);
 
+        uint64_t allocationsBefore = allocationCount;
         watch_.start();
         // Call commonAPI method loopCountPerPaylod times to calculate mean time
         for (uint32_t i = 0; i < loopCountPerPaylod; ++i) {
@@ -226,9 +251,10 @@ TEST_F(PFComplex, Ping_Pong_Complex_Asynchronous) {
             callCount_ = 0;
         }
         watch_.stop();
+        uint64_t allocations = allocationCount - allocationsBefore;
 
         // Printing results
-        printTestValues(arraySize_ * payloadSize, arraySize_ * sizeof(testStruct));
+        printTestValues(arraySize_ * payloadSize, arraySize_ * sizeof(testStruct), allocations);
 
         // Increase array size for next iteration
         arraySize_ *= 2;
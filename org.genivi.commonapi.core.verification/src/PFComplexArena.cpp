@@ -0,0 +1,170 @@
+/* Copyright (C) 2020 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/**
+* @file Performance_ComplexArena
+*/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <memory_resource>
+#include <new>
+#include <vector>
+#include "CommonAPI/CommonAPI.hpp"
+
+#include "v1/commonapi/performance/arena/TestInterface.hpp"
+
+#include "utils/StopWatch.hpp"
+
+// Define the max. array size to test
+const int maxArraySize = 4096 / 16;
+// Define the loop count how often a message is received for calculating the mean time
+const int loopCountPerPaylod = 1000;
+
+using namespace v1_0::commonapi::performance::arena;
+
+// Counts the heap allocations of the process to report the allocations per call. The
+// std::pmr::new_delete_resource allocates with the aligned operator new.
+static std::atomic<uint64_t> allocationCount(0);
+
+void *operator new(std::size_t _size) {
+    allocationCount++;
+    void *its_memory = std::malloc(_size == 0 ? 1 : _size);
+    if (its_memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return its_memory;
+}
+
+void *operator new(std::size_t _size, std::align_val_t _alignment) {
+    allocationCount++;
+    std::size_t its_alignment = std::max(static_cast<std::size_t>(_alignment), sizeof(void *));
+    void *its_memory = nullptr;
+    if (posix_memalign(&its_memory, its_alignment, _size == 0 ? 1 : _size) != 0) {
+        throw std::bad_alloc();
+    }
+    return its_memory;
+}
+
+void operator delete(void *_memory) noexcept {
+    std::free(_memory);
+}
+
+void operator delete(void *_memory, std::size_t) noexcept {
+    std::free(_memory);
+}
+
+void operator delete(void *_memory, std::align_val_t) noexcept {
+    std::free(_memory);
+}
+
+void operator delete(void *_memory, std::size_t, std::align_val_t) noexcept {
+    std::free(_memory);
+}
+
+class Environment: public ::testing::Environment {
+public:
+    virtual ~Environment() {
+    }
+
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+class PFComplexArena: public ::testing::Test {
+protected:
+    void SetUp() {
+        arena_.resize(1024 * 1024);
+    }
+
+    void TearDown() {
+    }
+
+    // Creates the message with arraySize_ elements. The string member does not fit into
+    // the small string buffer, so each element allocates.
+    TestInterface::tArray createMessage() {
+        TestInterface::tArray message;
+        TestInterface::innerStruct innerTestStruct(123, true, 4, "test string beyond the small string buffer", 35);
+        std::pmr::string unionMember("Hello World");
+        TestInterface::innerUnion innerTestUnion = unionMember;
+        TestInterface::tStruct testStruct(innerTestStruct, innerTestUnion);
+        for (uint32_t i = 0; i < arraySize_; ++i) {
+            message.push_back(testStruct);
+        }
+        return message;
+    }
+
+    void printTestValues(const std::string &_memory, uint64_t allocations) {
+        StopWatch::usec_t meanTime = (watch_.getTotalElapsedMicroseconds() / loopCountPerPaylod);
+        std::cout << "[MEASURING ]  " << std::setw(6) << std::left << std::setfill(' ') << _memory << std::right
+                  << " Array-Size=" << std::setw(4) << std::setfill('.') << arraySize_
+                  << ", Mean-Time=" << std::setw(7) << std::setfill('.') << meanTime << "us"
+                  << ", allocs/call=" << std::setw(5) << std::setfill('.') << (allocations / loopCountPerPaylod)
+                  << std::endl;
+    }
+
+    std::vector<char> arena_;
+    StopWatch watch_;
+    uint32_t arraySize_ = 1;
+};
+
+/**
+* @test Compare receiving a complex array into the global heap and into a monotonic arena
+*   - complex array is array of a struct containing an union and another struct with primitive datatypes
+*   - Receiving is simulated by copying the message into the out array
+*   - The arena is released at once after each call
+*   - Using double payload every cycle, starting with 1 end with maxArraySize
+*/
+TEST_F(PFComplexArena, Receive_Complex) {
+    while (arraySize_ <= maxArraySize) {
+        TestInterface::tArray in = createMessage();
+
+        uint64_t allocations = 0;
+        watch_.reset();
+        for (uint32_t i = 0; i < loopCountPerPaylod; ++i) {
+            uint64_t allocationsBefore = allocationCount;
+            watch_.start();
+            {
+                TestInterface::tArray out(in);
+                EXPECT_EQ(in.size(), out.size());
+            }
+            watch_.stop();
+            allocations += allocationCount - allocationsBefore;
+        }
+        printTestValues("heap", allocations);
+
+        allocations = 0;
+        watch_.reset();
+        for (uint32_t i = 0; i < loopCountPerPaylod; ++i) {
+            uint64_t allocationsBefore = allocationCount;
+            watch_.start();
+            {
+                std::pmr::monotonic_buffer_resource arena(arena_.data(), arena_.size());
+                TestInterface::tArray out(in, &arena);
+                EXPECT_EQ(in.size(), out.size());
+            }
+            watch_.stop();
+            allocations += allocationCount - allocationsBefore;
+        }
+        printTestValues("arena", allocations);
+
+        TestInterface::tArray out(in, std::pmr::new_delete_resource());
+        EXPECT_EQ(in, out);
+
+        arraySize_ *= 2;
+    }
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    ::testing::AddGlobalTestEnvironment(new Environment());
+    return RUN_ALL_TESTS();
+}
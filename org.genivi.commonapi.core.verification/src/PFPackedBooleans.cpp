@@ -0,0 +1,276 @@
+/* Copyright (C) 2020 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/**
+* @file Performance_PackedBooleans
+*/
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <iomanip>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "CommonAPI/CommonAPI.hpp"
+
+#include "v1/commonapi/performance/packed/TestInterface.hpp"
+
+#include "utils/StopWatch.hpp"
+
+// Number of array elements
+const size_t arraySize = 16 * 1024;
+// Define the loop count how often the array is scanned for calculating the mean time
+const int loopCount = 100;
+
+using namespace v1_0::commonapi::performance::packed;
+
+// Counts the elements whose flags 7 and 31 are set
+template<typename Array_>
+static size_t scanArray(const Array_ &_array) {
+    size_t count = 0;
+    for (const auto &status : _array) {
+        if (status.getFlag7() && status.getFlag31())
+            count++;
+    }
+    return count;
+}
+
+// Writes and reads the values of a struct one after another in host byte order, like a binding
+// (de)serializes the std::tuple of a CommonAPI::Struct. All values must be trivially copyable.
+template<size_t Index_, typename Tuple_>
+struct TupleSerializer {
+    static void write(const Tuple_ &_values, std::vector<uint8_t> &_buffer) {
+        TupleSerializer<Index_ - 1, Tuple_>::write(_values, _buffer);
+        const auto &value = std::get<Index_ - 1>(_values);
+        const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+        _buffer.insert(_buffer.end(), bytes, bytes + sizeof(value));
+    }
+    static size_t read(const std::vector<uint8_t> &_buffer, Tuple_ &_values) {
+        size_t offset = TupleSerializer<Index_ - 1, Tuple_>::read(_buffer, _values);
+        auto &value = std::get<Index_ - 1>(_values);
+        std::memcpy(&value, _buffer.data() + offset, sizeof(value));
+        return offset + sizeof(value);
+    }
+};
+
+template<typename Tuple_>
+struct TupleSerializer<0, Tuple_> {
+    static void write(const Tuple_ &, std::vector<uint8_t> &) {
+    }
+    static size_t read(const std::vector<uint8_t> &, Tuple_ &) {
+        return 0;
+    }
+};
+
+template<typename Struct_>
+static std::vector<uint8_t> serialize(const Struct_ &_struct) {
+    typedef decltype(_struct.values_) Tuple;
+    std::vector<uint8_t> buffer;
+    TupleSerializer<std::tuple_size<Tuple>::value, Tuple>::write(_struct.values_, buffer);
+    return buffer;
+}
+
+template<typename Struct_>
+static size_t deserialize(const std::vector<uint8_t> &_buffer, Struct_ &_struct) {
+    typedef decltype(_struct.values_) Tuple;
+    return TupleSerializer<std::tuple_size<Tuple>::value, Tuple>::read(_buffer, _struct.values_);
+}
+
+// Writes the values in host byte order, like a binding writes the members of a struct.
+class ByteOutputStream: public CommonAPI::OutputStream<ByteOutputStream> {
+public:
+    template<typename Type_>
+    OutputStream &writeValue(const Type_ &_value, const CommonAPI::EmptyDeployment *) {
+        const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&_value);
+        buffer_.insert(buffer_.end(), bytes, bytes + sizeof(_value));
+        return *this;
+    }
+    bool hasError() const {
+        return false;
+    }
+
+    std::vector<uint8_t> buffer_;
+};
+
+// Reads the values written by ByteOutputStream.
+class ByteInputStream: public CommonAPI::InputStream<ByteInputStream> {
+public:
+    ByteInputStream(const std::vector<uint8_t> &_buffer)
+        : buffer_(_buffer), offset_(0) {
+    }
+    template<typename Type_>
+    InputStream &readValue(Type_ &_value, const CommonAPI::EmptyDeployment *) {
+        std::memcpy(&_value, buffer_.data() + offset_, sizeof(_value));
+        offset_ += sizeof(_value);
+        return *this;
+    }
+    bool hasError() const {
+        return false;
+    }
+
+    const std::vector<uint8_t> &buffer_;
+    size_t offset_;
+};
+
+class Environment: public ::testing::Environment {
+public:
+    virtual ~Environment() {
+    }
+
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+class PFPackedBooleans: public ::testing::Test {
+protected:
+    void SetUp() {
+        for (uint32_t i = 0; i < arraySize; ++i) {
+            TestInterface::tStatus status;
+            status.setId(i);
+            status.setFlag7(i % 2 == 0);
+            status.setFlag31(i % 3 == 0);
+            statusArray_.push_back(status);
+            packedArray_.push_back(TestInterface::tStatusPacked(status));
+        }
+    }
+
+    void TearDown() {
+    }
+
+    void printTestValues(const std::string &_layout, size_t _objectSize) {
+        StopWatch::usec_t meanTime = (watch_.getTotalElapsedMicroseconds() / loopCount);
+        std::cout << "[MEASURING ]  " << std::setw(8) << std::left << std::setfill(' ') << _layout << std::right
+                  << " Object-Size=" << std::setw(4) << std::setfill('.') << _objectSize
+                  << ", Array-Size=" << std::setw(7) << std::setfill('.') << arraySize
+                  << ", Mean-Time=" << std::setw(7) << std::setfill('.') << meanTime << "us"
+                  << std::endl;
+    }
+
+    TestInterface::tStatusArray statusArray_;
+    std::vector<TestInterface::tStatusPacked> packedArray_;
+    StopWatch watch_;
+};
+
+/**
+* @test The companion struct of a struct deployed with PackBooleans stores its 32 Boolean members in one UInt32
+*   - The getters and setters of the packed struct behave like the ones of the unpacked struct
+*   - The struct deployed with PackBooleans and PackBooleansOnWire behaves the same
+*/
+TEST_F(PFPackedBooleans, Accessors) {
+    EXPECT_LT(sizeof(TestInterface::tStatusPacked), sizeof(TestInterface::tStatus));
+    EXPECT_LT(sizeof(TestInterface::tPackedStatus), sizeof(TestInterface::tStatus));
+
+    TestInterface::tStatusPacked packed;
+    EXPECT_FALSE(packed.getFlag0());
+    EXPECT_FALSE(packed.getFlag31());
+    packed.setFlag0(true);
+    packed.setFlag31(true);
+    EXPECT_TRUE(packed.getFlag0());
+    EXPECT_FALSE(packed.getFlag1());
+    EXPECT_TRUE(packed.getFlag31());
+    packed.setFlag0(false);
+    EXPECT_FALSE(packed.getFlag0());
+    EXPECT_TRUE(packed.getFlag31());
+
+    TestInterface::tPackedStatus packedStatus;
+    EXPECT_FALSE(packedStatus.getFlag0());
+    packedStatus.setFlag0(true);
+    packedStatus.setFlag31(true);
+    EXPECT_TRUE(packedStatus.getFlag0());
+    EXPECT_FALSE(packedStatus.getFlag1());
+    EXPECT_TRUE(packedStatus.getFlag31());
+}
+
+/**
+* @test The companion struct converts from and to the struct without losing a member
+*/
+TEST_F(PFPackedBooleans, Conversion) {
+    EXPECT_EQ(statusArray_[6], packedArray_[6].getValue());
+    EXPECT_EQ(TestInterface::tStatus(), TestInterface::tStatusPacked().getValue());
+    EXPECT_EQ(6u, packedArray_[6].getId());
+    EXPECT_TRUE(packedArray_[6].getFlag7());
+    EXPECT_FALSE(packedArray_[6].getFlag8());
+    EXPECT_TRUE(packedArray_[6].getFlag31());
+    EXPECT_NE(packedArray_[7], packedArray_[6]);
+}
+
+/**
+* @test The companion struct is written member by member with the Boolean members expanded
+*   - Its serialized form equals the one of the struct, so the deployment of the bindings applies
+*   - Reading the serialized values yields an equal companion struct
+*/
+TEST_F(PFPackedBooleans, Serialization) {
+    std::vector<uint8_t> buffer = serialize(statusArray_[6]);
+    EXPECT_EQ(sizeof(uint32_t) + 32 * sizeof(bool), buffer.size());
+
+    ByteOutputStream output;
+    packedArray_[6].writeValue(output, static_cast<const CommonAPI::EmptyDeployment *>(nullptr));
+    EXPECT_EQ(buffer, output.buffer_);
+
+    ByteInputStream input(buffer);
+    TestInterface::tStatusPacked packed;
+    packed.readValue(input, static_cast<const CommonAPI::EmptyDeployment *>(nullptr));
+    EXPECT_EQ(buffer.size(), input.offset_);
+    EXPECT_EQ(packedArray_[6], packed);
+    EXPECT_EQ(statusArray_[6], packed.getValue());
+}
+
+/**
+* @test The struct deployed with PackBooleansOnWire is serialized as its id and one UInt32 instead of 32 Booleans
+*   - Reading the serialized values yields an equal struct with the same flags
+*/
+TEST_F(PFPackedBooleans, SerializationOnWire) {
+    TestInterface::tPackedStatus packedStatus;
+    packedStatus.setId(6);
+    packedStatus.setFlag7(true);
+    packedStatus.setFlag31(true);
+
+    std::vector<uint8_t> buffer = serialize(packedStatus);
+    EXPECT_EQ(2 * sizeof(uint32_t), buffer.size());
+
+    TestInterface::tPackedStatus readStatus;
+    EXPECT_EQ(buffer.size(), deserialize(buffer, readStatus));
+    EXPECT_EQ(packedStatus, readStatus);
+    EXPECT_EQ(6u, readStatus.getId());
+    EXPECT_TRUE(readStatus.getFlag7());
+    EXPECT_FALSE(readStatus.getFlag8());
+    EXPECT_TRUE(readStatus.getFlag31());
+}
+
+/**
+* @test Compare scanning two flags of 16Ki structs with Boolean members and with packed Boolean members
+*   - Both scans must count the same elements
+*/
+TEST_F(PFPackedBooleans, Scan_Array) {
+    size_t count = 0;
+    watch_.reset();
+    for (int i = 0; i < loopCount; ++i) {
+        watch_.start();
+        count = scanArray(statusArray_);
+        watch_.stop();
+    }
+    printTestValues("Boolean", sizeof(TestInterface::tStatus));
+
+    size_t packedCount = 0;
+    watch_.reset();
+    for (int i = 0; i < loopCount; ++i) {
+        watch_.start();
+        packedCount = scanArray(packedArray_);
+        watch_.stop();
+    }
+    printTestValues("packed", sizeof(TestInterface::tStatusPacked));
+
+    EXPECT_EQ((arraySize + 5) / 6, count);
+    EXPECT_EQ(count, packedCount);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    ::testing::AddGlobalTestEnvironment(new Environment());
+    return RUN_ALL_TESTS();
+}
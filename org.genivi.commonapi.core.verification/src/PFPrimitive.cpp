@@ -7,8 +7,10 @@
 * @file Performance_Primitive
 */
 
+#include <algorithm>
 #include <gtest/gtest.h>
 #include <thread>
+#include <vector>
 #include "CommonAPI/CommonAPI.hpp"
 
 #include "v1/commonapi/performance/primitive/TestInterfaceProxy.hpp"
@@ -208,6 +210,156 @@ TEST_F(PFPrimitive, Ping_Pong_Primitive_Asynchronous) {
     }
 }
 
+/**
+* @test Measure the hit rate and the latency of the reply cache of a "Cacheable" method
+*   - The stub computes a 1024 byte array that only depends on the key
+*     - First every call is a miss (the cache is invalidated before each call)
+*     - Then the calls cycle through a working set of keys that fits into the cache
+*     - The replies of both runs must be identical, the cached run must hit the
+*       cache for all but the first call of each key and must call the stub
+*       implementation only once per key
+*     - The latencies are printed only, as they depend on the load of the machine
+*/
+TEST_F(PFPrimitive, Lookup_Cache_Hit_Rate) {
+    const uint32_t workingSetSize = 16;
+    CommonAPI::CallStatus callStatus;
+
+    std::shared_ptr<PFPrimitiveStub> stub = std::dynamic_pointer_cast<PFPrimitiveStub>(testStub_);
+    ASSERT_TRUE((bool)stub);
+
+    std::vector<TestInterface::TestArray> expected(workingSetSize);
+    uint32_t initialCalls = stub->getLookupCalls();
+
+    watch_.reset();
+    for (uint32_t i = 0; i < loopCountPerPaylod; ++i) {
+        TestInterface::TestArray out;
+        stub->invalidateLookupCache();
+        watch_.start();
+        testProxy_->lookup(i % workingSetSize, callStatus, out);
+        watch_.stop();
+        EXPECT_EQ(callStatus, CommonAPI::CallStatus::SUCCESS);
+        if (i < workingSetSize)
+            expected[i] = out;
+    }
+    StopWatch::usec_t uncachedTime = watch_.getTotalElapsedMicroseconds() / loopCountPerPaylod;
+    TestInterfaceStubDefault::CacheStatistics uncached = stub->getLookupCacheStatistics();
+    uint32_t uncachedCalls = stub->getLookupCalls() - initialCalls;
+
+    stub->invalidateLookupCache();
+    watch_.reset();
+    for (uint32_t i = 0; i < loopCountPerPaylod; ++i) {
+        TestInterface::TestArray out;
+        watch_.start();
+        testProxy_->lookup(i % workingSetSize, callStatus, out);
+        watch_.stop();
+        EXPECT_EQ(callStatus, CommonAPI::CallStatus::SUCCESS);
+        EXPECT_EQ(expected[i % workingSetSize], out);
+    }
+    StopWatch::usec_t cachedTime = watch_.getTotalElapsedMicroseconds() / loopCountPerPaylod;
+    TestInterfaceStubDefault::CacheStatistics statistics = stub->getLookupCacheStatistics();
+    uint32_t cachedCalls = stub->getLookupCalls() - initialCalls - uncachedCalls;
+
+    uint64_t hits = statistics.hits_ - uncached.hits_;
+    uint64_t misses = statistics.misses_ - uncached.misses_;
+    std::cout << "[MEASURING ]  Uncached Mean-Time=" << uncachedTime << "us"
+              << ", Cached Mean-Time=" << cachedTime << "us"
+              << ", Hit-Rate=" << (100 * hits) / (hits + misses) << "%"
+              << std::endl;
+
+    EXPECT_EQ(uncached.hits_, 0u);
+    EXPECT_EQ(misses, static_cast<uint64_t>(workingSetSize));
+    EXPECT_EQ(hits, static_cast<uint64_t>(loopCountPerPaylod - workingSetSize));
+    EXPECT_EQ(uncachedCalls, static_cast<uint32_t>(loopCountPerPaylod));
+    EXPECT_EQ(cachedCalls, workingSetSize);
+}
+
+/**
+* @test Check the hash of the reply cache keys
+*   - Equal arrays, structs and unions must have equal hashes
+*   - Arrays of the same size, structs and unions that differ in one element must have
+*     different hashes (a collision would still be resolved by comparing the keys, but
+*     makes every lookup compare all colliding keys)
+*/
+TEST_F(PFPrimitive, Lookup_Cache_Hash) {
+    typedef TestInterfaceStubDefault::CacheHash CacheHash;
+    TestInterface::TestArray array(1024, 0x55);
+    TestInterface::TestArray otherArray(array);
+    otherArray[512] = 0xAA;
+    EXPECT_EQ(CacheHash::get(array), CacheHash::get(TestInterface::TestArray(array)));
+    EXPECT_NE(CacheHash::get(array), CacheHash::get(otherArray));
+
+    CommonAPI::Struct<uint32_t, TestInterface::TestArray> value, otherValue;
+    value.values_ = std::make_tuple(7u, array);
+    otherValue.values_ = std::make_tuple(7u, otherArray);
+    EXPECT_EQ(CacheHash::get(value), CacheHash::get(CommonAPI::Struct<uint32_t, TestInterface::TestArray>(value)));
+    EXPECT_NE(CacheHash::get(value), CacheHash::get(otherValue));
+
+    CommonAPI::Variant<uint32_t, TestInterface::TestArray> element(array), otherElement(otherArray);
+    EXPECT_EQ(CacheHash::get(element), CacheHash::get(CommonAPI::Variant<uint32_t, TestInterface::TestArray>(array)));
+    EXPECT_NE(CacheHash::get(element), CacheHash::get(otherElement));
+    EXPECT_NE(CacheHash::get(std::make_tuple(1u, array)), CacheHash::get(std::make_tuple(1u, otherArray)));
+}
+
+/**
+* @test Test a streamed reply (ReplyChunkSize = 16 KiB)
+*   - The stub writes the elements of each requested chunk through the chunk writer
+*     - The proxy receives the reply chunk by chunk and checks the content of each chunk
+*     - Using double payload every cycle, starting with 1 MiB end with maxStreamedSize
+*     - No chunk may exceed the chunk size, the number of received elements must match
+*/
+TEST_F(PFPrimitive, Streamed_Reply) {
+    const uint64_t maxStreamedSize = 64 * 1024 * 1024;
+    const std::size_t chunkSize = 16384;
+
+    for (uint64_t size = 1024 * 1024; size <= maxStreamedSize; size *= 2) {
+        uint64_t received = 0;
+        std::size_t maxChunk = 0;
+        bool isValid = true;
+        bool isFinished = false;
+        uint64_t total = 0;
+        CommonAPI::CallStatus status = CommonAPI::CallStatus::UNKNOWN;
+
+        watch_.reset();
+        watch_.start();
+        testProxy_->downloadStream(size,
+            [&](const TestInterface::TestArray &_chunk) {
+                maxChunk = std::max(maxChunk, _chunk.size());
+                for (std::size_t i = 0; i < _chunk.size(); ++i) {
+                    if (_chunk[i] != static_cast<uint8_t>((received + i) & 0xFF))
+                        isValid = false;
+                }
+                received += _chunk.size();
+            },
+            [&](const CommonAPI::CallStatus &_status, uint64_t _total) {
+                std::unique_lock<std::mutex> uniqueLock(synchLock_);
+                status = _status;
+                total = _total;
+                isFinished = true;
+                condVar_.notify_one();
+            });
+        {
+            std::unique_lock<std::mutex> uniqueLock(synchLock_);
+            while (!isFinished) {
+                condVar_.wait(uniqueLock);
+            }
+        }
+        watch_.stop();
+
+        StopWatch::usec_t streamTime = watch_.getTotalElapsedMicroseconds();
+        std::cout << "[MEASURING ]  Size=" << std::setw(9) << std::setfill('.') << size
+                  << ", Time=" << std::setw(9) << std::setfill('.') << streamTime << "us"
+                  << ", MiB/s=" << std::setw(7) << std::setfill('.')
+                  << (streamTime > 0 ? (size * usecPerSecond) / (streamTime * 1024 * 1024) : 0)
+                  << std::endl;
+
+        EXPECT_EQ(status, CommonAPI::CallStatus::SUCCESS);
+        EXPECT_EQ(total, size);
+        EXPECT_EQ(received, size);
+        EXPECT_LE(maxChunk, chunkSize);
+        EXPECT_TRUE(isValid);
+    }
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     ::testing::AddGlobalTestEnvironment(new Environment());
@@ -0,0 +1,263 @@
+/* Copyright (C) 2020 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/**
+* @file Performance_StructOfArrays
+*/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "CommonAPI/CommonAPI.hpp"
+
+#include "v1/commonapi/performance/soa/TestInterface.hpp"
+
+#include "utils/StopWatch.hpp"
+
+// Number of array elements
+const size_t arraySize = 16 * 1024;
+// Define the loop count how often the array is scanned or written for calculating the mean time
+const int loopCount = 100;
+
+using namespace v1_0::commonapi::performance::soa;
+
+// Writes a value in host byte order
+template<typename Type_>
+static uint8_t *writeValue(uint8_t *_buffer, const Type_ &_value) {
+    std::memcpy(_buffer, &_value, sizeof(Type_));
+    return _buffer + sizeof(Type_);
+}
+
+static uint8_t *writeValue(uint8_t *_buffer, const std::string &_value) {
+    _buffer = writeValue(_buffer, static_cast<uint32_t>(_value.size()));
+    std::memcpy(_buffer, _value.data(), _value.size());
+    return _buffer + _value.size();
+}
+
+static uint8_t *writeValue(uint8_t *_buffer, const TestInterface::tState &_value) {
+    _buffer = writeValue(_buffer, static_cast<uint8_t>(_value.isType<bool>() ? 1 : 2));
+    if (_value.isType<bool>())
+        return writeValue(_buffer, _value.get<bool>());
+    return writeValue(_buffer, _value.get<std::string>());
+}
+
+// The array of structs is written element by element
+static size_t writeArray(const TestInterface::tMeasurements &_measurements, uint8_t *_buffer) {
+    uint8_t *its_buffer = _buffer;
+    for (const TestInterface::tMeasurement &measurement : _measurements) {
+        its_buffer = writeValue(its_buffer, measurement.getId());
+        its_buffer = writeValue(its_buffer, measurement.getValue());
+        its_buffer = writeValue(its_buffer, measurement.getLabel());
+        its_buffer = writeValue(its_buffer, measurement.getState());
+    }
+    return static_cast<size_t>(its_buffer - _buffer);
+}
+
+// The structure of arrays is written column by column, fixed size columns are copied at once
+template<typename Type_>
+static uint8_t *writeColumn(uint8_t *_buffer, const std::vector<Type_> &_values) {
+    std::memcpy(_buffer, _values.data(), _values.size() * sizeof(Type_));
+    return _buffer + _values.size() * sizeof(Type_);
+}
+
+template<typename Type_>
+static uint8_t *writeColumn(uint8_t *_buffer, const std::vector<Type_> &_values, bool) {
+    for (const Type_ &value : _values)
+        _buffer = writeValue(_buffer, value);
+    return _buffer;
+}
+
+static size_t writeStructureOfArrays(const TestInterface::tMeasurementsSoA &_measurements, uint8_t *_buffer) {
+    uint8_t *its_buffer = _buffer;
+    its_buffer = writeColumn(its_buffer, _measurements.getIdValues());
+    its_buffer = writeColumn(its_buffer, _measurements.getValueValues());
+    its_buffer = writeColumn(its_buffer, _measurements.getLabelValues(), true);
+    its_buffer = writeColumn(its_buffer, _measurements.getStateValues(), true);
+    return static_cast<size_t>(its_buffer - _buffer);
+}
+
+class Environment: public ::testing::Environment {
+public:
+    virtual ~Environment() {
+    }
+
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+class PFStructOfArrays: public ::testing::Test {
+protected:
+    void SetUp() {
+        for (uint32_t i = 0; i < arraySize; ++i) {
+            TestInterface::tState state;
+            if (i % 8 == 0)
+                state = std::string("sensor timeout");
+            else
+                state = true;
+            measurements_.push_back(TestInterface::tMeasurement(i, static_cast<double>(i) / 4,
+                    "measurement " + std::to_string(i % 100), state));
+        }
+        soa_ = TestInterface::tMeasurementsSoA(measurements_);
+    }
+
+    void TearDown() {
+    }
+
+    void printTestValues(const std::string &_layout) {
+        StopWatch::usec_t meanTime = (watch_.getTotalElapsedMicroseconds() / loopCount);
+        std::cout << "[MEASURING ]  " << std::setw(21) << std::left << std::setfill(' ') << _layout << std::right
+                  << " Array-Size=" << std::setw(7) << std::setfill('.') << arraySize
+                  << ", Mean-Time=" << std::setw(7) << std::setfill('.') << meanTime << "us"
+                  << std::endl;
+    }
+
+    TestInterface::tMeasurements measurements_;
+    TestInterface::tMeasurementsSoA soa_;
+    StopWatch watch_;
+};
+
+/**
+* @test The structure of arrays holds the elements of the array
+*   - The element proxies read and write the members of one element
+*   - The iteration visits all elements in order
+*/
+TEST_F(PFStructOfArrays, Conversion) {
+    ASSERT_EQ(measurements_.size(), soa_.size());
+    EXPECT_EQ(measurements_, soa_.toArray());
+    EXPECT_EQ(measurements_[3], static_cast<TestInterface::tMeasurement>(soa_[3]));
+
+    TestInterface::tMeasurementsSoA soa(soa_);
+    soa[3].setValue(42.0);
+    EXPECT_EQ(42.0, soa.getValueValues()[3]);
+    EXPECT_NE(soa_, soa);
+    soa[3] = measurements_[3];
+    EXPECT_EQ(soa_, soa);
+
+    uint32_t id = 0;
+    for (auto measurement : soa_) {
+        EXPECT_EQ(id, measurement.getId());
+        id++;
+    }
+    EXPECT_EQ(arraySize, id);
+}
+
+/**
+* @test The iterators of the structure of arrays work with the standard algorithms
+*   - The distance, the random access and the member access through the iterator match the array
+*/
+TEST_F(PFStructOfArrays, Iterator) {
+    typedef std::iterator_traits<TestInterface::tMeasurementsSoA::const_iterator> Traits;
+    static_assert(std::is_same<Traits::iterator_category, std::random_access_iterator_tag>::value,
+                  "the iterator must be a random access iterator");
+    static_assert(std::is_same<Traits::value_type, TestInterface::tMeasurement>::value,
+                  "the value type must be the struct");
+
+    EXPECT_EQ(static_cast<std::ptrdiff_t>(arraySize), std::distance(soa_.begin(), soa_.end()));
+    EXPECT_EQ(measurements_[5].getId(), soa_.begin()[5].getId());
+    EXPECT_EQ(measurements_[5].getId(), (soa_.end() - static_cast<std::ptrdiff_t>(arraySize - 5))->getId());
+
+    TestInterface::tMeasurementsSoA::const_iterator it = soa_.begin();
+    TestInterface::tMeasurementsSoA::const_iterator previous = it++;
+    EXPECT_EQ(soa_.begin(), previous);
+    EXPECT_EQ(1, it - previous);
+    EXPECT_TRUE(previous < it);
+
+    TestInterface::tMeasurementsSoA soa(soa_);
+    soa.begin()->setValue(42.0);
+    EXPECT_EQ(42.0, soa.getValueValues()[0]);
+}
+
+/**
+* @test The elements of the structure of arrays can be sorted with std::sort
+*   - Swapping two elements through the iterators swaps all their members
+*   - The comparison takes the struct, like the comparison of std::vector<bool> takes bool
+*/
+TEST_F(PFStructOfArrays, Sort) {
+    auto byLabelAndValue = [](const TestInterface::tMeasurement &_first, const TestInterface::tMeasurement &_second) {
+        return (_first.getLabel() < _second.getLabel()
+                || (_first.getLabel() == _second.getLabel() && _first.getValue() > _second.getValue()));
+    };
+
+    TestInterface::tMeasurementsSoA soa(soa_);
+    std::sort(soa.begin(), soa.end(), byLabelAndValue);
+
+    TestInterface::tMeasurements measurements(measurements_);
+    std::sort(measurements.begin(), measurements.end(), byLabelAndValue);
+    EXPECT_EQ(measurements, soa.toArray());
+
+    std::iter_swap(soa.begin(), soa.begin() + 1);
+    EXPECT_EQ(measurements[1], static_cast<TestInterface::tMeasurement>(soa[0]));
+    EXPECT_EQ(measurements[0], static_cast<TestInterface::tMeasurement>(soa[1]));
+}
+
+/**
+* @test Compare scanning one member of 16Ki elements in the array of structs and in the structure of arrays
+*   - Both layouts must yield the same sum
+*/
+TEST_F(PFStructOfArrays, Scan_Member) {
+    double aosSum = 0.0;
+    watch_.reset();
+    for (int i = 0; i < loopCount; ++i) {
+        watch_.start();
+        for (const TestInterface::tMeasurement &measurement : measurements_)
+            aosSum += measurement.getValue();
+        watch_.stop();
+    }
+    printTestValues("array of structs");
+
+    double soaSum = 0.0;
+    watch_.reset();
+    for (int i = 0; i < loopCount; ++i) {
+        watch_.start();
+        for (double value : soa_.getValueValues())
+            soaSum += value;
+        watch_.stop();
+    }
+    printTestValues("structure of arrays");
+
+    EXPECT_EQ(aosSum, soaSum);
+}
+
+/**
+* @test Compare writing 16Ki elements in the array of structs and in the structure of arrays layout
+*   - Both layouts must write the same number of bytes
+*/
+TEST_F(PFStructOfArrays, Write_Array) {
+    std::vector<uint8_t> buffer(arraySize * 64);
+
+    size_t aosSize = 0;
+    watch_.reset();
+    for (int i = 0; i < loopCount; ++i) {
+        watch_.start();
+        aosSize = writeArray(measurements_, buffer.data());
+        watch_.stop();
+    }
+    printTestValues("array of structs");
+
+    size_t soaSize = 0;
+    watch_.reset();
+    for (int i = 0; i < loopCount; ++i) {
+        watch_.start();
+        soaSize = writeStructureOfArrays(soa_, buffer.data());
+        watch_.stop();
+    }
+    printTestValues("structure of arrays");
+
+    EXPECT_EQ(aosSize, soaSize);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    ::testing::AddGlobalTestEnvironment(new Environment());
+    return RUN_ALL_TESTS();
+}
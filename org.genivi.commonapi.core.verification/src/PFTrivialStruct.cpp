@@ -0,0 +1,223 @@
+/* Copyright (C) 2020 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/**
+* @file Performance_TrivialStruct
+*/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <vector>
+#include "CommonAPI/CommonAPI.hpp"
+
+#include "v1/commonapi/performance/trivial/TestInterface.hpp"
+
+#include "utils/StopWatch.hpp"
+
+// Number of array elements
+const size_t arraySize = 16 * 1024;
+// Define the loop count how often the array is copied for calculating the mean time
+const int loopCount = 100;
+
+using namespace v1_0::commonapi::performance::trivial;
+
+// The serialized layout is big endian
+static bool isLittleEndian() {
+    const uint16_t one = 1;
+    return (*reinterpret_cast<const uint8_t *>(&one) == 1);
+}
+
+// The current path: each member is written on its own
+template<typename Type_>
+static uint8_t *writeMember(uint8_t *_buffer, const Type_ &_value, bool _swap) {
+    std::memcpy(_buffer, &_value, sizeof(Type_));
+    if (_swap)
+        std::reverse(_buffer, _buffer + sizeof(Type_));
+    return _buffer + sizeof(Type_);
+}
+
+template<typename Type_>
+static const uint8_t *readMember(const uint8_t *_buffer, Type_ &_value, bool _swap) {
+    uint8_t bytes[sizeof(Type_)];
+    std::memcpy(bytes, _buffer, sizeof(Type_));
+    if (_swap)
+        std::reverse(bytes, bytes + sizeof(Type_));
+    std::memcpy(&_value, bytes, sizeof(Type_));
+    return _buffer + sizeof(Type_);
+}
+
+static void writeMembers(const TestInterface::tSamples &_samples, uint8_t *_buffer, bool _swap) {
+    for (const TestInterface::tSample &sample : _samples) {
+        _buffer = writeMember(_buffer, sample.getId(), _swap);
+        _buffer = writeMember(_buffer, sample.getValue(), _swap);
+        _buffer = writeMember(_buffer, sample.getChannel(), _swap);
+        _buffer = writeMember(_buffer, static_cast<uint8_t>(sample.getKind()), _swap);
+        _buffer = writeMember(_buffer, static_cast<uint8_t>(sample.getValid()), _swap);
+    }
+}
+
+static void readMembers(const uint8_t *_buffer, TestInterface::tSamples &_samples, bool _swap) {
+    for (TestInterface::tSample &sample : _samples) {
+        uint32_t id;
+        float value;
+        uint16_t channel;
+        uint8_t kind;
+        uint8_t valid;
+        _buffer = readMember(_buffer, id, _swap);
+        _buffer = readMember(_buffer, value, _swap);
+        _buffer = readMember(_buffer, channel, _swap);
+        _buffer = readMember(_buffer, kind, _swap);
+        _buffer = readMember(_buffer, valid, _swap);
+        sample = TestInterface::tSample(id, value, channel,
+                static_cast<TestInterface::tKind::Literal>(kind), valid != 0);
+    }
+}
+
+// The bulk path: the structs are converted to their trivially copyable representation,
+// which is copied at once
+static void writeData(const TestInterface::tSamples &_samples, std::vector<TestInterface::tSampleData> &_data,
+        uint8_t *_buffer, bool _swap) {
+    for (size_t i = 0; i < _samples.size(); ++i) {
+        _data[i] = _samples[i].getData();
+    }
+    TestInterface::tSampleData::write(_data.data(), _data.size(), _buffer, _swap);
+}
+
+static void readData(const uint8_t *_buffer, std::vector<TestInterface::tSampleData> &_data,
+        TestInterface::tSamples &_samples, bool _swap) {
+    TestInterface::tSampleData::read(_buffer, _data.size(), _data.data(), _swap);
+    for (size_t i = 0; i < _data.size(); ++i) {
+        _samples[i] = TestInterface::tSample(_data[i]);
+    }
+}
+
+class Environment: public ::testing::Environment {
+public:
+    virtual ~Environment() {
+    }
+
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+class PFTrivialStruct: public ::testing::Test {
+protected:
+    void SetUp() {
+        swap_ = isLittleEndian();
+        for (uint32_t i = 0; i < arraySize; ++i) {
+            TestInterface::tSample sample(i, static_cast<float>(i) / 4, static_cast<uint16_t>(i % 64),
+                    TestInterface::tKind::KIND_FILTERED, (i % 3) != 0);
+            samples_.push_back(sample);
+            data_.push_back(sample.getData());
+        }
+    }
+
+    void TearDown() {
+    }
+
+    void printTestValues(const std::string &_path) {
+        StopWatch::usec_t meanTime = (watch_.getTotalElapsedMicroseconds() / loopCount);
+        std::cout << "[MEASURING ]  " << std::setw(14) << std::left << std::setfill(' ') << _path << std::right
+                  << " Array-Size=" << std::setw(7) << std::setfill('.') << arraySize
+                  << ", Mean-Time=" << std::setw(7) << std::setfill('.') << meanTime << "us"
+                  << std::endl;
+    }
+
+    bool swap_;
+    TestInterface::tSamples samples_;
+    std::vector<TestInterface::tSampleData> data_;
+    StopWatch watch_;
+};
+
+/**
+* @test The members of tSampleData have the packed serialized layout
+*   - Booleans are stored as uint8_t, the conversion to tSample maps every byte other than 0 to true
+*/
+TEST_F(PFTrivialStruct, Layout) {
+    // UInt32, Float, UInt16, enumeration (UInt8), Boolean (uint8_t)
+    EXPECT_EQ(12u, sizeof(TestInterface::tSampleData));
+
+    TestInterface::tSample sample(data_[3]);
+    EXPECT_EQ(samples_[3], sample);
+
+    TestInterface::tSampleData data = data_[4];
+    data.valid = 0x02;
+    TestInterface::tSample normalized(data);
+    EXPECT_TRUE(normalized.getValid());
+    EXPECT_EQ(1u, normalized.getData().valid);
+    data.valid = 0;
+    EXPECT_FALSE(TestInterface::tSample(data).getValid());
+}
+
+/**
+* @test Compare writing an array of 16Ki structs member by member with the bulk copy
+*   - The bulk copy includes the conversion of the structs with getData()
+*   - The buffers of both paths must be equal
+*/
+TEST_F(PFTrivialStruct, Write_Array) {
+    std::vector<uint8_t> memberBuffer(arraySize * sizeof(TestInterface::tSampleData));
+    std::vector<uint8_t> bulkBuffer(arraySize * sizeof(TestInterface::tSampleData));
+    std::vector<TestInterface::tSampleData> data(arraySize);
+
+    watch_.reset();
+    for (int i = 0; i < loopCount; ++i) {
+        watch_.start();
+        writeMembers(samples_, memberBuffer.data(), swap_);
+        watch_.stop();
+    }
+    printTestValues("member-wise");
+
+    watch_.reset();
+    for (int i = 0; i < loopCount; ++i) {
+        watch_.start();
+        writeData(samples_, data, bulkBuffer.data(), swap_);
+        watch_.stop();
+    }
+    printTestValues("memcpy");
+
+    EXPECT_EQ(memberBuffer, bulkBuffer);
+}
+
+/**
+* @test Compare reading an array of 16Ki structs member by member with the bulk copy
+*   - The bulk copy includes the construction of the structs from their representation
+*   - Both paths must read the written samples
+*/
+TEST_F(PFTrivialStruct, Read_Array) {
+    std::vector<uint8_t> buffer(arraySize * sizeof(TestInterface::tSampleData));
+    TestInterface::tSampleData::write(data_.data(), data_.size(), buffer.data(), swap_);
+
+    TestInterface::tSamples samples(arraySize);
+    watch_.reset();
+    for (int i = 0; i < loopCount; ++i) {
+        watch_.start();
+        readMembers(buffer.data(), samples, swap_);
+        watch_.stop();
+    }
+    printTestValues("member-wise");
+    EXPECT_EQ(samples_, samples);
+
+    std::vector<TestInterface::tSampleData> data(arraySize);
+    TestInterface::tSamples bulkSamples(arraySize);
+    watch_.reset();
+    for (int i = 0; i < loopCount; ++i) {
+        watch_.start();
+        readData(buffer.data(), data, bulkSamples, swap_);
+        watch_.stop();
+    }
+    printTestValues("memcpy");
+    EXPECT_EQ(samples_, bulkSamples);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    ::testing::AddGlobalTestEnvironment(new Environment());
+    return RUN_ALL_TESTS();
+}
@@ -7,10 +7,15 @@
 * @file StabilitySP
 */
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <fstream>
 #include <gtest/gtest.h>
+#include <iostream>
 #include <thread>
+#include <vector>
 #include "CommonAPI/CommonAPI.hpp"
 #include "v1/commonapi/stability/sp/TestInterfaceProxy.hpp"
 #include "stub/StabilitySPStub.hpp"
@@ -969,6 +974,163 @@ TEST_F(StabilitySP, MultipleAttributeSubscriptions) {
     }
 }
 
+/**
+* @test Measure the throughput of a method that is deployed with StubDispatch "Parallel".
+*    - Set a processing delay in the stub to simulate a blocking method implementation.
+*    - For 1, 2, 4 and 8 stub dispatcher workers:
+*    -   Create MAXTHREADCOUNT threads, each of which sends STUBWORKERCALLS messages.
+*    -   Each message is MESSAGESIZE bytes long.
+*    - Test fails if any of the calls fail or return a wrong value, if the stub does not
+*      process every call exactly once, if more calls run concurrently than there are workers
+*      if the calls never run concurrently with more than one worker or if the throughput
+*      does not grow with the number of workers: every step must gain at least 20% and
+*      MAXTHREADCOUNT workers must reach at least 2.5 times the throughput of one worker.
+*      The ideal gains are 100% and MAXTHREADCOUNT times, as the calls mostly wait.
+**/
+TEST_F(StabilitySP, StubWorkerThroughputScaling) {
+    const unsigned int STUBWORKERCALLS = 10;
+    const uint32_t STUBPROCESSINGDELAY = 2000;
+    const std::vector<std::size_t> workerCounts = { 1, 2, 4, 8 };
+
+    std::shared_ptr<StabilitySPStub> stub = std::dynamic_pointer_cast<StabilitySPStub>(testStub_);
+    ASSERT_TRUE((bool)stub);
+    stub->setProcessingDelay(STUBPROCESSINGDELAY);
+
+    TestInterface::tArray in;
+    for (unsigned int messageindex = 0; messageindex < MESSAGESIZE; messageindex++) {
+        in.push_back((unsigned char)(messageindex & 0xFF));
+    }
+
+    std::vector<double> throughputs;
+    for (auto workers : workerCounts) {
+        ASSERT_TRUE(stub->setStubDispatcherWorkers(workers));
+        stub->resetCallCounters();
+
+        std::atomic<unsigned int> failures(0);
+        std::vector<std::thread> callers;
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned int threadcount = 0; threadcount < MAXTHREADCOUNT; threadcount++) {
+            callers.push_back(std::thread([&]() {
+                for (unsigned int callcount = 0; callcount < STUBWORKERCALLS; callcount++) {
+                    CommonAPI::CallStatus callStatus;
+                    TestInterface::tArray out;
+                    testProxy_->testMethod(in, callStatus, out);
+                    if (callStatus != CommonAPI::CallStatus::SUCCESS || out != in)
+                        failures++;
+                }
+            }));
+        }
+        for (auto &caller : callers) {
+            caller.join();
+        }
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start).count();
+
+        double throughput = (MAXTHREADCOUNT * STUBWORKERCALLS * 1000000.0) / (duration > 0 ? duration : 1);
+        std::cout << "StubDispatch Parallel, " << workers << " worker(s): "
+                  << throughput << " calls/s, " << stub->getMaxConcurrentCalls()
+                  << " concurrent call(s)" << std::endl;
+
+        {
+#ifdef _WIN32
+            std::lock_guard<std::mutex> gtestLock(gtestMutex);
+#endif
+            EXPECT_EQ(0u, failures);
+            EXPECT_EQ(MAXTHREADCOUNT * STUBWORKERCALLS, stub->getProcessedCalls());
+            EXPECT_LE(stub->getMaxConcurrentCalls(), workers);
+            if (workers > 1)
+                EXPECT_GT(stub->getMaxConcurrentCalls(), 1u);
+            if (!throughputs.empty())
+                EXPECT_GT(throughput, 1.2 * throughputs.back());
+        }
+        throughputs.push_back(throughput);
+    }
+    {
+#ifdef _WIN32
+        std::lock_guard<std::mutex> gtestLock(gtestMutex);
+#endif
+        EXPECT_GT(throughputs.back(), 2.5 * throughputs.front());
+    }
+    stub->setProcessingDelay(0);
+}
+
+/**
+* @test Flood a stub whose dispatcher queue is bounded.
+*    - Use a single stub dispatcher worker with a processing delay and a queue limit.
+*    - Create 4 * MAXTHREADCOUNT threads, each of which sends OVERLOADCALLS messages.
+*    - Test fails if no calls are shed, if the queue depth exceeds the limit, if a call
+*      is neither processed nor rejected, if the single worker runs calls concurrently or
+*      if the p99 latency exceeds a generous multiple of (queue limit + 1) * processing delay.
+**/
+TEST_F(StabilitySP, OverloadSheddingBoundsLatency) {
+    const unsigned int OVERLOADTHREADS = 4 * MAXTHREADCOUNT;
+    const unsigned int OVERLOADCALLS = 20;
+    const std::size_t QUEUELIMIT = 4;
+    const uint32_t STUBPROCESSINGDELAY = 2000;
+    // An accepted call waits for at most QUEUELIMIT calls and the running one, a rejected call for
+    // none. The bound leaves a factor of ten for the transport and the scheduling of the threads.
+    const int64_t P99LATENCYBOUND = 10 * static_cast<int64_t>(QUEUELIMIT + 1) * STUBPROCESSINGDELAY;
+
+    std::shared_ptr<StabilitySPStub> stub = std::dynamic_pointer_cast<StabilitySPStub>(testStub_);
+    ASSERT_TRUE((bool)stub);
+    ASSERT_TRUE(stub->setStubDispatcherWorkers(1));
+    stub->setStubQueueLimit(QUEUELIMIT);
+    stub->setProcessingDelay(STUBPROCESSINGDELAY);
+    stub->resetCallCounters();
+
+    TestInterface::tArray in;
+    for (unsigned int messageindex = 0; messageindex < MESSAGESIZE; messageindex++) {
+        in.push_back((unsigned char)(messageindex & 0xFF));
+    }
+
+    std::mutex latenciesMutex;
+    std::vector<int64_t> latencies;
+    std::atomic<unsigned int> succeeded(0);
+    std::vector<std::thread> callers;
+    for (unsigned int threadcount = 0; threadcount < OVERLOADTHREADS; threadcount++) {
+        callers.push_back(std::thread([&]() {
+            std::vector<int64_t> ownLatencies;
+            for (unsigned int callcount = 0; callcount < OVERLOADCALLS; callcount++) {
+                CommonAPI::CallStatus callStatus;
+                TestInterface::tArray out;
+                auto start = std::chrono::steady_clock::now();
+                testProxy_->testMethod(in, callStatus, out);
+                ownLatencies.push_back(std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - start).count());
+                if (callStatus == CommonAPI::CallStatus::SUCCESS && out == in)
+                    succeeded++;
+            }
+            std::lock_guard<std::mutex> itsLock(latenciesMutex);
+            latencies.insert(latencies.end(), ownLatencies.begin(), ownLatencies.end());
+        }));
+    }
+    for (auto &caller : callers) {
+        caller.join();
+    }
+    stub->setProcessingDelay(0);
+    stub->setStubQueueLimit(0);
+
+    std::sort(latencies.begin(), latencies.end());
+    int64_t p99 = latencies[(latencies.size() * 99) / 100];
+    auto statistics = stub->getStubDispatcherStatistics();
+    std::cout << "Overload: " << succeeded << " of " << latencies.size() << " calls succeeded, "
+              << statistics.rejected_ << " rejected, max queue depth " << statistics.maxDepth_
+              << ", p99 latency " << p99 << " us" << std::endl;
+
+    {
+#ifdef _WIN32
+        std::lock_guard<std::mutex> gtestLock(gtestMutex);
+#endif
+        EXPECT_GT(statistics.rejected_, 0u);
+        EXPECT_GT(succeeded, 0u);
+        EXPECT_LE(statistics.maxDepth_, QUEUELIMIT);
+        EXPECT_EQ(succeeded, stub->getProcessedCalls());
+        EXPECT_EQ(OVERLOADTHREADS * OVERLOADCALLS, succeeded + statistics.rejected_);
+        EXPECT_EQ(1u, stub->getMaxConcurrentCalls());
+        EXPECT_LE(p99, P99LATENCYBOUND);
+    }
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     ::testing::AddGlobalTestEnvironment(new Environment());
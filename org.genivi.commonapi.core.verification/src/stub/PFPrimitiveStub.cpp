@@ -13,7 +13,8 @@ namespace performance {
 namespace primitive {
 
 
-PFPrimitiveStub::PFPrimitiveStub() {
+PFPrimitiveStub::PFPrimitiveStub()
+    : lookupCalls_(0) {
 
 }
 
@@ -31,6 +32,38 @@ void PFPrimitiveStub::testMethod(const std::shared_ptr<CommonAPI::ClientId> _cli
     _reply(y);
 }
 
+void PFPrimitiveStub::lookupUncached(const std::shared_ptr<CommonAPI::ClientId> _client,
+        uint32_t _key, lookupReply_t _reply) {
+    (void)_client;
+    lookupCalls_++;
+    TestInterface::TestArray y(1024);
+
+    // Simulate an expensive lookup that only depends on the key
+    uint32_t value = _key;
+    for (uint32_t round = 0; round < 64; ++round) {
+        for (auto &element : y) {
+            value = value * 1103515245u + 12345u;
+            element = static_cast<uint8_t>(element ^ (value >> 16));
+        }
+    }
+    _reply(y);
+}
+
+uint32_t PFPrimitiveStub::getLookupCalls() const {
+    return lookupCalls_;
+}
+
+void PFPrimitiveStub::downloadStream(const std::shared_ptr<CommonAPI::ClientId> _client,
+        uint64_t _size, DownloadChunkWriter &_writer) {
+    (void)_client;
+
+    // Produce the elements of the requested chunk only
+    for (uint64_t i = _writer.getOffset(); i < _size; ++i) {
+        if (!_writer.write(static_cast<uint8_t>(i & 0xFF)))
+            break;
+    }
+}
+
 } /* namespace primitive */
 } /* namespace datatypes */
 } /* namespace commonapi */
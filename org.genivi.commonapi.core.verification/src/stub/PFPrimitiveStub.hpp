@@ -6,6 +6,8 @@
 #ifndef PFPRIMITIVESTUB_HPP_
 #define PFPRIMITIVESTUB_HPP_
 
+#include <atomic>
+
 #include "v1/commonapi/performance/primitive/TestInterfaceStubDefault.hpp"
 
 namespace v1 {
@@ -19,6 +21,13 @@ public:
     virtual ~PFPrimitiveStub();
 
     virtual void testMethod(const std::shared_ptr<CommonAPI::ClientId> _client, TestInterface::TestArray _x, testMethodReply_t _reply);
+    virtual void lookupUncached(const std::shared_ptr<CommonAPI::ClientId> _client, uint32_t _key, lookupReply_t _reply);
+    virtual void downloadStream(const std::shared_ptr<CommonAPI::ClientId> _client, uint64_t _size, DownloadChunkWriter &_writer);
+
+    uint32_t getLookupCalls() const;
+
+private:
+    std::atomic<uint32_t> lookupCalls_;
 };
 
 } /* namespace primitive */
@@ -3,6 +3,9 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <chrono>
+#include <thread>
+
 #include "StabilitySPStub.hpp"
 
 #ifndef _WIN32
@@ -16,16 +19,34 @@ namespace sp {
 
 using namespace v1_0::commonapi::stability::sp;
 
-StabilitySPStub::StabilitySPStub() {
+StabilitySPStub::StabilitySPStub()
+    : processingDelay_(0),
+      processedCalls_(0),
+      concurrentCalls_(0),
+      maxConcurrentCalls_(0) {
 }
 
 StabilitySPStub::~StabilitySPStub() {
+    stopStubDispatcher();
 }
 
-void StabilitySPStub::testMethod(const std::shared_ptr<CommonAPI::ClientId> _client,
+void StabilitySPStub::testMethodDispatched(const std::shared_ptr<CommonAPI::ClientId> _client,
+        const CommonAPI::CallId_t _call,
         TestInterface::tArray _tArrayIn,
-        testMethodReply_t _reply) {
+        testMethodReply_t _reply,
+        testMethodTestOverloadedReply_t _testMethodTestOverloadedReply) {
     (void)_client;
+    (void)_call;
+    (void)_testMethodTestOverloadedReply;
+
+        uint32_t concurrent = ++concurrentCalls_;
+        uint32_t maxConcurrent = maxConcurrentCalls_;
+        while (concurrent > maxConcurrent
+                && !maxConcurrentCalls_.compare_exchange_weak(maxConcurrent, concurrent));
+
+        uint32_t delay = processingDelay_;
+        if (delay > 0)
+            std::this_thread::sleep_for(std::chrono::microseconds(delay));
 
         TestInterface::tArray tArrayOut;
 
@@ -35,6 +56,9 @@ void StabilitySPStub::testMethod(const std::shared_ptr<CommonAPI::ClientId> _cli
             _tArrayIn
         );
 
+        concurrentCalls_--;
+        processedCalls_++;
+
         _reply(tArrayOut);
 
 
@@ -44,6 +68,23 @@ void StabilitySPStub::setTestValues(const TestInterface::tArray &_x) {
     setTestAttributeAttribute(_x);
 }
 
+void StabilitySPStub::setProcessingDelay(uint32_t _microseconds) {
+    processingDelay_ = _microseconds;
+}
+
+void StabilitySPStub::resetCallCounters() {
+    processedCalls_ = 0;
+    maxConcurrentCalls_ = 0;
+}
+
+uint32_t StabilitySPStub::getProcessedCalls() const {
+    return processedCalls_;
+}
+
+uint32_t StabilitySPStub::getMaxConcurrentCalls() const {
+    return maxConcurrentCalls_;
+}
+
 } /* namespace v1 */
 } /* namespace sp */
 } /* namespace stability */
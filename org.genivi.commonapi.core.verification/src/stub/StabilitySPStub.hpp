@@ -6,6 +6,8 @@
 #ifndef STABILITYSPSTUB_HPP_
 #define STABILITYSPSTUB_HPP_
 
+#include <atomic>
+
 #include "v1/commonapi/stability/sp/TestInterfaceStubDefault.hpp"
 #include "v1/commonapi/stability/sp/TestInterface.hpp"
 
@@ -20,10 +22,22 @@ public:
     StabilitySPStub();
     virtual ~StabilitySPStub();
 
-    virtual void testMethod(const std::shared_ptr<CommonAPI::ClientId> _client,
+    virtual void testMethodDispatched(const std::shared_ptr<CommonAPI::ClientId> _client,
+            const CommonAPI::CallId_t _call,
             TestInterface::tArray _x,
-            testMethodReply_t _reply);
+            testMethodReply_t _reply,
+            testMethodTestOverloadedReply_t _testMethodTestOverloadedReply);
     virtual void setTestValues(const TestInterface::tArray &_x);
+    virtual void setProcessingDelay(uint32_t _microseconds);
+    virtual void resetCallCounters();
+    virtual uint32_t getProcessedCalls() const;
+    virtual uint32_t getMaxConcurrentCalls() const;
+
+private:
+    std::atomic<uint32_t> processingDelay_;
+    std::atomic<uint32_t> processedCalls_;
+    std::atomic<uint32_t> concurrentCalls_;
+    std::atomic<uint32_t> maxConcurrentCalls_;
 };
 
 } /* namespace v1 */
@@ -17,6 +17,7 @@ import org.franca.core.franca.FField;
 import org.franca.core.franca.FInterface;
 import org.franca.core.franca.FMethod;
 import org.franca.core.franca.FModelElement;
+import org.franca.core.franca.FStructType;
 import org.franca.deploymodel.core.FDeployedInterface;
 import org.franca.deploymodel.core.FDeployedRootElement;
 import org.franca.deploymodel.core.FDeployedTypeCollection;
@@ -60,6 +61,14 @@ public class Deployment {
 			signal, error
 		}
 
+		public enum StubDispatch {
+			Inline, Serialized, Parallel
+		}
+
+		public enum ArrayLayout {
+			AoS, SoA
+		}
+
 	}
 
 	/**
@@ -70,6 +79,13 @@ public class Deployment {
 	public interface IDataPropertyAccessor
 		extends Enums
 	{
+		// host 'arrays'
+		public ArrayLayout getArrayLayout(FArrayType obj);
+
+		// host 'structs'
+		public Boolean getPackBooleans(FStructType obj);
+		public Boolean getPackBooleansOnWire(FStructType obj);
+
 		// host 'enumerations'
 		public EnumBackingType getEnumBackingType(FEnumerationType obj);
 
@@ -172,6 +188,24 @@ public class Deployment {
 			return null;
 		}
 
+		public static StubDispatch convertStubDispatch(String val) {
+			if (val.equals("Inline"))
+				return StubDispatch.Inline; else
+			if (val.equals("Serialized"))
+				return StubDispatch.Serialized; else
+			if (val.equals("Parallel"))
+				return StubDispatch.Parallel;
+			return null;
+		}
+
+		public static ArrayLayout convertArrayLayout(String val) {
+			if (val.equals("AoS"))
+				return ArrayLayout.AoS; else
+			if (val.equals("SoA"))
+				return ArrayLayout.SoA;
+			return null;
+		}
+
 
 		protected IDataPropertyAccessor getOverwriteAccessorAux(FModelElement obj) {
 			FDOverwriteElement fd = (FDOverwriteElement)target.getFDElement(obj);
@@ -198,6 +232,24 @@ public class Deployment {
 			this.helper = new DataPropertyAccessorHelper(target, this);
 		}
 
+		// host 'arrays'
+		@Override
+		public ArrayLayout getArrayLayout(FArrayType obj) {
+			String e = target.getEnum(obj, "ArrayLayout");
+			if (e==null) return null;
+			return DataPropertyAccessorHelper.convertArrayLayout(e);
+		}
+
+		// host 'structs'
+		@Override
+		public Boolean getPackBooleans(FStructType obj) {
+			return target.getBoolean(obj, "PackBooleans");
+		}
+		@Override
+		public Boolean getPackBooleansOnWire(FStructType obj) {
+			return target.getBoolean(obj, "PackBooleansOnWire");
+		}
+
 		// host 'enumerations'
 		@Override
 		public EnumBackingType getEnumBackingType(FEnumerationType obj) {
@@ -245,6 +297,9 @@ public class Deployment {
 		public Integer getDefaultTimeout(FInterface obj) {
 			return target.getInteger(obj, "DefaultTimeout");
 		}
+		public Integer getStubQueueLimit(FInterface obj) {
+			return target.getInteger(obj, "StubQueueLimit");
+		}
 
 		// host 'methods'
 		public Integer getMethodTimeout(FMethod obj) {
@@ -253,6 +308,23 @@ public class Deployment {
 		public List<String> getErrors(FMethod obj) {
 			return target.getStringArray(obj, "Errors");
 		}
+		public StubDispatch getStubDispatch(FMethod obj) {
+			String e = target.getEnum(obj, "StubDispatch");
+			if (e==null) return null;
+			return DataPropertyAccessorHelper.convertStubDispatch(e);
+		}
+		public String getOverloadError(FMethod obj) {
+			return target.getString(obj, "OverloadError");
+		}
+		public Boolean getCacheable(FMethod obj) {
+			return target.getBoolean(obj, "Cacheable");
+		}
+		public Integer getCacheSize(FMethod obj) {
+			return target.getInteger(obj, "CacheSize");
+		}
+		public Integer getReplyChunkSize(FMethod obj) {
+			return target.getInteger(obj, "ReplyChunkSize");
+		}
 
 		// host 'attributes'
 		public Integer getAttributeSetterTimeout(FAttribute obj) {
@@ -270,6 +342,24 @@ public class Deployment {
 			return DataPropertyAccessorHelper.convertAttributeNotifierUpdateMode(e);
 		}
 
+		// host 'arrays'
+		@Override
+		public ArrayLayout getArrayLayout(FArrayType obj) {
+			String e = target.getEnum(obj, "ArrayLayout");
+			if (e==null) return null;
+			return DataPropertyAccessorHelper.convertArrayLayout(e);
+		}
+
+		// host 'structs'
+		@Override
+		public Boolean getPackBooleans(FStructType obj) {
+			return target.getBoolean(obj, "PackBooleans");
+		}
+		@Override
+		public Boolean getPackBooleansOnWire(FStructType obj) {
+			return target.getBoolean(obj, "PackBooleansOnWire");
+		}
+
 		// host 'enumerations'
 		@Override
 		public EnumBackingType getEnumBackingType(FEnumerationType obj) {
@@ -415,6 +505,40 @@ public class Deployment {
 			}
 		}
 
+		// host 'arrays'
+		@Override
+		public ArrayLayout getArrayLayout(FArrayType obj) {
+			if (overwrites!=null) {
+				String e = target.getEnum(overwrites, "ArrayLayout");
+				if (e!=null) {
+					return DataPropertyAccessorHelper.convertArrayLayout(e);
+				}
+			}
+			return delegate.getArrayLayout(obj);
+		}
+
+		// host 'structs'
+		@Override
+		public Boolean getPackBooleans(FStructType obj) {
+			if (overwrites!=null) {
+				Boolean v = target.getBoolean(overwrites, "PackBooleans");
+				if (v!=null) {
+					return v;
+				}
+			}
+			return delegate.getPackBooleans(obj);
+		}
+		@Override
+		public Boolean getPackBooleansOnWire(FStructType obj) {
+			if (overwrites!=null) {
+				Boolean v = target.getBoolean(overwrites, "PackBooleansOnWire");
+				if (v!=null) {
+					return v;
+				}
+			}
+			return delegate.getPackBooleansOnWire(obj);
+		}
+
 		// host 'enumerations'
 		@Override
 		public EnumBackingType getEnumBackingType(FEnumerationType obj) {
@@ -12,7 +12,9 @@ import org.franca.core.franca.FAttribute;
 import org.franca.core.franca.FBroadcast;
 import org.franca.core.franca.FEnumerationType;
 import org.franca.core.franca.FField;
+import org.franca.core.franca.FInterface;
 import org.franca.core.franca.FMethod;
+import org.franca.core.franca.FStructType;
 import org.franca.deploymodel.core.FDeployedInterface;
 import org.franca.deploymodel.core.FDeployedTypeCollection;
 import org.franca.deploymodel.dsl.fDeploy.FDExtensionElement;
@@ -122,6 +124,63 @@ public class PropertyAccessor {
 		signal, error
 	}
 
+	public enum ArrayLayout {
+		AoS, SoA
+	}
+
+	public ArrayLayout getArrayLayout(FArrayType obj) {
+		try {
+			switch (type_) {
+			case INTERFACE:
+			case TYPE_COLLECTION:
+			case OVERWRITE:
+				return from(dataAccessor_.getArrayLayout(obj));
+			case PROVIDER:
+			case NONE:
+			default:
+				return ArrayLayout.AoS;
+			}
+		}
+		catch (java.lang.NullPointerException e) {}
+		return ArrayLayout.AoS;
+	}
+
+	public Boolean getPackBooleans(FStructType obj) {
+		try {
+			switch (type_) {
+			case INTERFACE:
+			case TYPE_COLLECTION:
+			case OVERWRITE:
+				Boolean packBooleans = dataAccessor_.getPackBooleans(obj);
+				return (packBooleans != null && packBooleans);
+			case PROVIDER:
+			case NONE:
+			default:
+				return false;
+			}
+		}
+		catch (java.lang.NullPointerException e) {}
+		return false;
+	}
+
+	public Boolean getPackBooleansOnWire(FStructType obj) {
+		try {
+			switch (type_) {
+			case INTERFACE:
+			case TYPE_COLLECTION:
+			case OVERWRITE:
+				Boolean packBooleansOnWire = dataAccessor_.getPackBooleansOnWire(obj);
+				return (packBooleansOnWire != null && packBooleansOnWire);
+			case PROVIDER:
+			case NONE:
+			default:
+				return false;
+			}
+		}
+		catch (java.lang.NullPointerException e) {}
+		return false;
+	}
+
 	public Integer getTimeout(FMethod obj) {
 		try {
 			if (type_ == DeploymentType.INTERFACE)
@@ -140,6 +199,64 @@ public class PropertyAccessor {
 		return null;
 	}
 
+	public enum StubDispatch {
+		Inline, Serialized, Parallel
+	}
+
+	public StubDispatch getStubDispatch(FMethod obj) {
+		try {
+			if (type_ == DeploymentType.INTERFACE)
+				return from(((Deployment.InterfacePropertyAccessor)dataAccessor_).getStubDispatch(obj));
+		}
+		catch (java.lang.NullPointerException e) {}
+		return StubDispatch.Inline;
+	}
+
+	public String getOverloadError(FMethod obj) {
+		try {
+			if (type_ == DeploymentType.INTERFACE)
+				return ((Deployment.InterfacePropertyAccessor)dataAccessor_).getOverloadError(obj);
+		}
+		catch (java.lang.NullPointerException e) {}
+		return null;
+	}
+
+	public Boolean getCacheable(FMethod obj) {
+		try {
+			if (type_ == DeploymentType.INTERFACE)
+				return ((Deployment.InterfacePropertyAccessor)dataAccessor_).getCacheable(obj);
+		}
+		catch (java.lang.NullPointerException e) {}
+		return false;
+	}
+
+	public Integer getCacheSize(FMethod obj) {
+		try {
+			if (type_ == DeploymentType.INTERFACE)
+				return ((Deployment.InterfacePropertyAccessor)dataAccessor_).getCacheSize(obj);
+		}
+		catch (java.lang.NullPointerException e) {}
+		return 64;
+	}
+
+	public Integer getReplyChunkSize(FMethod obj) {
+		try {
+			if (type_ == DeploymentType.INTERFACE)
+				return ((Deployment.InterfacePropertyAccessor)dataAccessor_).getReplyChunkSize(obj);
+		}
+		catch (java.lang.NullPointerException e) {}
+		return 0;
+	}
+
+	public Integer getStubQueueLimit(FInterface obj) {
+		try {
+			if (type_ == DeploymentType.INTERFACE)
+				return ((Deployment.InterfacePropertyAccessor)dataAccessor_).getStubQueueLimit(obj);
+		}
+		catch (java.lang.NullPointerException e) {}
+		return 0;
+	}
+
 	public String getDomain (FDExtensionElement obj) {
 		try {
 			if (type_ == DeploymentType.PROVIDER)
@@ -232,4 +349,30 @@ public class PropertyAccessor {
 		}
 		return BroadcastType.signal;
 	}
+
+	private ArrayLayout from(Deployment.Enums.ArrayLayout _source) {
+		if (_source != null) {
+			switch (_source) {
+			case SoA:
+				return ArrayLayout.SoA;
+			default:
+				return ArrayLayout.AoS;
+			}
+		}
+		return ArrayLayout.AoS;
+	}
+
+	private StubDispatch from(Deployment.InterfacePropertyAccessor.StubDispatch _source) {
+		if (_source != null) {
+			switch (_source) {
+			case Serialized:
+				return StubDispatch.Serialized;
+			case Parallel:
+				return StubDispatch.Parallel;
+			default:
+				return StubDispatch.Inline;
+			}
+		}
+		return StubDispatch.Inline;
+	}
 }
@@ -4,17 +4,22 @@
    file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 package org.genivi.commonapi.core.generator;
 
+import java.io.InputStream;
+import java.security.MessageDigest;
 import java.util.ArrayList;
 import java.util.Collections;
 import java.util.HashMap;
+import java.util.HashSet;
 import java.util.Iterator;
 import java.util.List;
 import java.util.Map;
+import java.util.Set;
 
 import org.eclipse.emf.common.util.URI;
 import org.eclipse.emf.ecore.EObject;
 import org.eclipse.emf.ecore.resource.Resource;
 import org.eclipse.emf.ecore.resource.ResourceSet;
+import org.eclipse.emf.ecore.resource.URIConverter;
 import org.eclipse.emf.ecore.resource.impl.ResourceSetImpl;
 import org.franca.core.dsl.FrancaImportsProvider;
 import org.franca.core.franca.FModel;
@@ -29,6 +34,11 @@ import org.genivi.commonapi.core.verification.ValidateElements;
  * The FDeployManager loads models from fdepl files and from fidl files that are
  * imported in a fdepl file. It continues to import files even it could not find
  * all of them (e.g an unknown deployment specification).
+ * Loaded files are kept together with the hash of their contents. They are
+ * only parsed again if their contents changed.
+ * The models are loaded into the resource set of the generated resource (see
+ * setResourceSet), so files that were already loaded by the caller are not parsed
+ * again and are released together with the resource set.
  *
  * @author gutknecht
  *
@@ -48,18 +58,47 @@ public class FDeployManager {
 	private Map<String, FModel> fidlModels = new HashMap<String, FModel>();
 	private Map<String, FDSpecification> specifications = new HashMap<String, FDSpecification>();
 	private List<String> importsLoadedList = new ArrayList<String>();
+	private Map<String, String> contentHashes = new HashMap<String, String>();
+	private Set<String> validatedModels = new HashSet<String>();
+	private Set<String> loadedModels = new HashSet<String>();
 	private ValidateElements validateElements = new ValidateElements();
 
 	public FDeployManager() {
 
-		resourceSet = new ResourceSetImpl();
-
 		// we expect fdepl files
 		fileHandlerRegistry.put(fdeplExtension, new FDeployImportsProvider());
 		// allow for fidl file imports
 		fileHandlerRegistry.put("fidl", new FrancaImportsProvider());
 	}
 
+	/**
+	 * Load the models into the given resource set, e.g. the one of the input resource.
+	 * If the resource set changes, the models loaded into the previous one are forgotten.
+	 *
+	 * @param _resourceSet
+	 *            the resource set to load the models into, null to release the models
+	 *            and to use a private resource set
+	 */
+	public void setResourceSet(ResourceSet _resourceSet) {
+		if (_resourceSet != resourceSet) {
+			resourceSet = _resourceSet;
+			deploymentModels.clear();
+			fidlModels.clear();
+			specifications.clear();
+			importsLoadedList.clear();
+			contentHashes.clear();
+			validatedModels.clear();
+			loadedModels.clear();
+		}
+	}
+
+	private ResourceSet getResourceSet() {
+		if (resourceSet == null) {
+			resourceSet = new ResourceSetImpl();
+		}
+		return resourceSet;
+	}
+
 	/**
 	 *
 	 * Load the model found in the fileName. Its dependencies (imports) can be
@@ -94,21 +133,35 @@ public class FDeployManager {
 //		}
 
 		// load root model
+		String absName = absURI.toString();
+		ResourceSet resourceSet = getResourceSet();
 		Resource resource = null;
 		try {
-			resource = resourceSet.getResource(absURI, true);
-			// Set the isLoaded flag to false in order to force reloading of
-			// fdepl/fidl files
-			resource.unload();
-			resource.load(Collections.EMPTY_MAP);
+			String contentHash = getContentHash(resourceSet.getURIConverter(), absURI);
+			resource = resourceSet.getResource(absURI, false);
+			if (resource == null) {
+				resource = resourceSet.getResource(absURI, true);
+				contentHashes.put(absName, contentHash);
+				validatedModels.remove(absName);
+			} else if (!resource.isLoaded() || contentHash == null
+					|| !contentHash.equals(contentHashes.get(absName))) {
+				// Set the isLoaded flag to false in order to force reloading of
+				// changed fdepl/fidl files
+				resource.unload();
+				resource.load(Collections.EMPTY_MAP);
+				contentHashes.put(absName, contentHash);
+				validatedModels.remove(absName);
+			}
 		} catch (Exception e) {
 			// Don't show an error message here, because code may be generated
 			// from an included fidl file.
 			// System.err.println("Failed to load model from : " + absURI + "(" + e.getMessage() +")");
+			contentHashes.remove(absName);
 			return null;
 		}
 
 		EObject model = resource.getContents().get(0);
+		loadedModels.add(absName);
 
 		// load all its imports recursively
 		for (Iterator<String> it = fileHandlerRegistry.get(
@@ -131,6 +184,8 @@ public class FDeployManager {
 //						.put(importURI, resolvedURI);
 				String uriName = resolvedURI.toString();
 				EObject importModel = null;
+				// record the import even if it was loaded before
+				loadedModels.add(uriName);
 
                 if (!importsLoadedList.contains(uriName))
                 {
@@ -158,12 +213,15 @@ public class FDeployManager {
 			}
 		}
 
+		// The validation renames elements, it must not be applied twice to a cached model
 		if (model instanceof FDModel) {
-			validateElements.validateFDModelElements((FDModel)model);
+			if (validatedModels.add(absName)) {
+				validateElements.validateFDModelElements((FDModel)model);
+			}
 		}
 		else if(model instanceof FModel) {
 			String rootUriString = root.toString();
-			if (rootUriString.endsWith("fidl")) {
+			if (rootUriString.endsWith("fidl") && validatedModels.add(absName)) {
 				validateElements.validateFModelElements((FModel)model);
 			}
 		}
@@ -171,6 +229,33 @@ public class FDeployManager {
 		return model;
 	}
 
+	/**
+	 * Calculate the hash of the contents of the given file
+	 *
+	 * @param converter
+	 *            the URI converter to open the file
+	 * @param uri
+	 *            the URI of the file
+	 * @return the hash or null if the file could not be read
+	 */
+	public static String getContentHash(URIConverter converter, URI uri) {
+		try (InputStream input = converter.createInputStream(uri)) {
+			MessageDigest digest = MessageDigest.getInstance("SHA-1");
+			byte[] buffer = new byte[8192];
+			int count;
+			while ((count = input.read(buffer)) > 0) {
+				digest.update(buffer, 0, count);
+			}
+			StringBuilder hash = new StringBuilder();
+			for (byte b : digest.digest()) {
+				hash.append(String.format("%02x", b));
+			}
+			return hash.toString();
+		} catch (Exception e) {
+			return null;
+		}
+	}
+
 	/**
 	 * @return the file extension this class will deal with (.fdepl)
 	 */
@@ -196,7 +281,7 @@ public class FDeployManager {
 				// load model
 				Resource resource = null;
 				try {
-					resource = resourceSet.getResource(fidlUri, true);
+					resource = getResourceSet().getResource(fidlUri, true);
 					resource.load(Collections.EMPTY_MAP);
 				} catch (Exception e) {
 					// failed to load model from fidl
@@ -224,6 +309,18 @@ public class FDeployManager {
 		fidlModels.clear();
 	}
 	
+	/**
+	 * @return the URIs of all files loaded since the last call of
+	 *         clearLoadedModels, including deployment specifications
+	 */
+	public Set<String> getLoadedModels() {
+		return loadedModels;
+	}
+
+	public void clearLoadedModels() {
+		loadedModels.clear();
+	}
+
 	public FDSpecification getDeploymentSpecification(String name) {
 		return specifications.get(name);
 	}
@@ -4,13 +4,21 @@
    file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 package org.genivi.commonapi.core.generator
 
+import com.google.common.base.Charsets
+import com.google.common.hash.Hasher
+import com.google.common.hash.Hashing
+import java.util.ArrayList
 import java.util.Collection
 import java.util.HashSet
 import javax.inject.Inject
 import org.eclipse.core.resources.IResource
 import org.eclipse.xtext.generator.IFileSystemAccess
+import org.franca.core.franca.FAttribute
+import org.franca.core.franca.FBroadcast
 import org.franca.core.franca.FInterface
 import org.franca.core.franca.FMethod
+import org.franca.core.franca.FModelElement
+import org.franca.core.franca.FTypedElement
 import org.franca.core.franca.FVersion
 import org.genivi.commonapi.core.deployment.PropertyAccessor
 import org.genivi.commonapi.core.preferences.FPreferences
@@ -30,15 +38,48 @@ class FInterfaceGenerator {
             fileSystemAccess.generateFile(fInterface.headerPath, IFileSystemAccess.DEFAULT_OUTPUT, fInterface.generateHeader(modelid, deploymentAccessor))
             if (fInterface.hasSourceFile)
                 fileSystemAccess.generateFile(fInterface.sourcePath, IFileSystemAccess.DEFAULT_OUTPUT, fInterface.generateSource(modelid, deploymentAccessor))
+            if (leanHeaders)
+                fileSystemAccess.generateFile(fInterface.fwdHeaderPath, IFileSystemAccess.DEFAULT_OUTPUT, fInterface.generateFwdHeader)
         }
         else {
             // feature: suppress code generation
             fileSystemAccess.generateFile(fInterface.headerPath, IFileSystemAccess.DEFAULT_OUTPUT, PreferenceConstants::NO_CODE)
             if (fInterface.hasSourceFile)
                 fileSystemAccess.generateFile(fInterface.sourcePath, IFileSystemAccess.DEFAULT_OUTPUT, PreferenceConstants::NO_CODE)
+            if (leanHeaders)
+                fileSystemAccess.generateFile(fInterface.fwdHeaderPath, IFileSystemAccess.DEFAULT_OUTPUT, PreferenceConstants::NO_CODE)
         }
     }
 
+    /**
+     * Declares the classes of the interface, its proxies and its stubs. The nested types
+     * can not be declared without the interface, they are only available in the header.
+     */
+    def private generateFwdHeader(FInterface fInterface) '''
+        «generateCommonApiLicenseHeader()»
+        «FTypeGenerator::generateComments(fInterface, false)»
+        #ifndef «fInterface.defineName.toUpperCase»_FWD_HPP_
+        #define «fInterface.defineName.toUpperCase»_FWD_HPP_
+
+        «fInterface.generateVersionNamespaceBegin»
+        «fInterface.model.generateNamespaceBeginDeclaration»
+
+        class «fInterface.elementName»;
+
+        class «fInterface.proxyBaseClassName»;
+        template <typename ... _AttributeExtensions>
+        class «fInterface.elementName»Proxy;
+        typedef «fInterface.elementName»Proxy<> «fInterface.elementName»ProxyDefault;
+
+        class «fInterface.stubClassName»;
+        class «fInterface.stubDefaultClassName»;
+
+        «fInterface.model.generateNamespaceEndDeclaration»
+        «fInterface.generateVersionNamespaceEnd»
+
+        #endif // «fInterface.defineName.toUpperCase»_FWD_HPP_
+    '''
+
     def generateInstanceIds(FInterface fInterface, IFileSystemAccess fileSystemAccess,  List<String> deployedInstances) {
         if(FPreferences::getInstance.getPreference(PreferenceConstants::P_GENERATE_CODE, "true").equals("true")) {
             fileSystemAccess.generateFile(fInterface.instanceHeaderPath, IFileSystemAccess.DEFAULT_OUTPUT, fInterface.generateInstanceHeader(deployedInstances))
@@ -112,6 +153,9 @@ class FInterfaceGenerator {
 
             static inline const char* getInterface();
             static inline CommonAPI::Version getInterfaceVersion();
+            /// Structural fingerprint of the interface elements and their types. Peers with the
+            /// same interface version but a different fingerprint are not compatible.
+            static constexpr uint32_t getInterfaceFingerprint() { return «String.format("0x%08X", fInterface.interfaceFingerprint)»; }
             «fInterface.generateFTypeDeclarations(deploymentAccessor)»
             «fInterface.generateFConstDeclarations(deploymentAccessor)»
         };
@@ -134,6 +178,10 @@ class FInterfaceGenerator {
            «type.generateFTypeInlineImplementation(fInterface, deploymentAccessor)»
         «ENDFOR»
 
+        «IF interfaceMetadata»
+            «fInterface.generateInterfaceMetadata(deploymentAccessor)»
+
+        «ENDIF»
         «fInterface.model.generateNamespaceEndDeclaration»
         «fInterface.generateVersionNamespaceEnd»
 
@@ -171,8 +219,158 @@ class FInterfaceGenerator {
         «fInterface.generateVersionNamespaceEnd»
     '''
 
+    /**
+     * Generates the compile-time metadata of the elements of the interface. The layout is
+     * described in the CommonAPI C++ specification (Interface Metadata). The metadata is a
+     * class template, so that its static members can be defined in the header (C++11).
+     */
+    def private generateInterfaceMetadata(FInterface fInterface, PropertyAccessor deploymentAccessor) '''
+        «val itsElements = new ArrayList<String>»
+        «val itsArguments = new ArrayList<String>»
+        «val itsHasher = Hashing::murmur3_32.newHasher»
+        «{itsHasher.putString(fInterface.fullyQualifiedNameWithVersion, Charsets::UTF_8);""}»
+        «FOR itsElement : fInterface.elements»
+            «{itsHasher.putInt(itsElement.addMetadataElement(deploymentAccessor, itsElements, itsArguments));""}»
+        «ENDFOR»
+        «val itsClassName = fInterface.elementName + "MetadataTable"»
+        template <typename _Dummy = void>
+        struct «itsClassName» {
+            enum ElementKind : uint8_t {
+                KIND_ATTRIBUTE = 0,
+                KIND_METHOD = 1,
+                KIND_FIRE_AND_FORGET_METHOD = 2,
+                KIND_BROADCAST = 3,
+                KIND_SELECTIVE_BROADCAST = 4,
+                KIND_CONSTANT = 5
+            };
+
+            enum ArgumentDirection : uint8_t {
+                ARGUMENT_IN = 0,
+                ARGUMENT_OUT = 1
+            };
+
+            struct Argument {
+                const char *name;
+                ArgumentDirection direction;
+                const char *typeName;
+                uint32_t typeId;
+            };
+
+            struct Element {
+                const char *name;
+                ElementKind kind;
+                uint32_t firstArgument;
+                uint32_t argumentCount;
+                uint32_t signatureHash;
+            };
+
+            static constexpr const char *INTERFACE_NAME = "«fInterface.fullyQualifiedNameWithVersion»";
+            static constexpr uint32_t ELEMENT_COUNT = «itsElements.size»;
+            static constexpr uint32_t ARGUMENT_COUNT = «itsArguments.size»;
+            static constexpr uint32_t SIGNATURE_HASH = «itsHasher.hash.asInt.toMetadataHex»;
+
+            static constexpr Element ELEMENTS[] = {
+                «FOR itsElement : itsElements»
+                    «itsElement»,
+                «ENDFOR»
+                { nullptr, KIND_CONSTANT, 0, 0, 0 }
+            };
+
+            static constexpr Argument ARGUMENTS[] = {
+                «FOR itsArgument : itsArguments»
+                    «itsArgument»,
+                «ENDFOR»
+                { nullptr, ARGUMENT_IN, nullptr, 0 }
+            };
+        };
+
+        template <typename _Dummy>
+        constexpr const char *«itsClassName»<_Dummy>::INTERFACE_NAME;
+        template <typename _Dummy>
+        constexpr uint32_t «itsClassName»<_Dummy>::ELEMENT_COUNT;
+        template <typename _Dummy>
+        constexpr uint32_t «itsClassName»<_Dummy>::ARGUMENT_COUNT;
+        template <typename _Dummy>
+        constexpr uint32_t «itsClassName»<_Dummy>::SIGNATURE_HASH;
+        template <typename _Dummy>
+        constexpr typename «itsClassName»<_Dummy>::Element «itsClassName»<_Dummy>::ELEMENTS[];
+        template <typename _Dummy>
+        constexpr typename «itsClassName»<_Dummy>::Argument «itsClassName»<_Dummy>::ARGUMENTS[];
+
+        typedef «itsClassName»<> «fInterface.elementName»Metadata;
+    '''
+
+    /**
+     * Adds the metadata entries of the element and its arguments.
+     * @return the signature hash of the element
+     */
+    def private int addMetadataElement(FModelElement _element, PropertyAccessor _accessor,
+                                       List<String> _elements, List<String> _arguments) {
+        var String itsKind = "KIND_CONSTANT"
+        val List<FTypedElement> itsInArguments = new ArrayList<FTypedElement>()
+        val List<FTypedElement> itsOutArguments = new ArrayList<FTypedElement>()
+        if (_element instanceof FAttribute) {
+            itsKind = "KIND_ATTRIBUTE"
+            itsOutArguments.add(_element)
+        } else if (_element instanceof FMethod) {
+            itsKind = if (_element.fireAndForget) "KIND_FIRE_AND_FORGET_METHOD" else "KIND_METHOD"
+            itsInArguments.addAll(_element.inArgs)
+            itsOutArguments.addAll(_element.outArgs)
+        } else if (_element instanceof FBroadcast) {
+            itsKind = if (_element.selective) "KIND_SELECTIVE_BROADCAST" else "KIND_BROADCAST"
+            itsOutArguments.addAll(_element.outArgs)
+        }
+
+        val itsHasher = Hashing::murmur3_32.newHasher
+        itsHasher.putString(_element.elementName, Charsets::UTF_8)
+        itsHasher.putString(itsKind, Charsets::UTF_8)
+        val itsFirstArgument = _arguments.size
+        for (itsArgument : itsInArguments) {
+            _arguments.add(itsArgument.getMetadataArgument("ARGUMENT_IN", _accessor, itsHasher))
+        }
+        for (itsArgument : itsOutArguments) {
+            _arguments.add(itsArgument.getMetadataArgument("ARGUMENT_OUT", _accessor, itsHasher))
+        }
+        val itsSignatureHash = itsHasher.hash.asInt
+        _elements.add("{ \"" + _element.elementName + "\", " + itsKind + ", " + itsFirstArgument + ", "
+            + (_arguments.size - itsFirstArgument) + ", " + itsSignatureHash.toMetadataHex + " }")
+        return itsSignatureHash
+    }
+
+    /**
+     * The type id is the hash of the type signature, it is equal for structurally equal types.
+     */
+    def private String getMetadataArgument(FTypedElement _argument, String _direction,
+                                           PropertyAccessor _accessor, Hasher _hasher) {
+        val String itsSignature = (if (_argument.array) "[]" else "") + _argument.type.actualTypeStreamSignature(_accessor)
+        val int itsTypeId = Hashing::murmur3_32.hashString(itsSignature, Charsets::UTF_8).asInt
+        _hasher.putString(_direction, Charsets::UTF_8)
+        _hasher.putInt(itsTypeId)
+        return "{ \"" + _argument.elementName + "\", " + _direction + ", \"" + _argument.metadataTypeName + "\", "
+            + itsTypeId.toMetadataHex + " }"
+    }
+
+    def private String getMetadataTypeName(FTypedElement _element) {
+        var String itsName
+        if (_element.type.derived !== null) {
+            itsName = _element.type.derived.fullyQualifiedName
+        } else if (_element.type.interval !== null) {
+            itsName = "Integer"
+        } else {
+            itsName = _element.type.predefined.getName
+        }
+        return if (_element.array) itsName + "[]" else itsName
+    }
+
+    def private String toMetadataHex(int _hash) {
+        return String.format("0x%08X", _hash)
+    }
+
     def void getRequiredHeaderFiles(FInterface fInterface, Collection<String> generatedHeaders, Collection<String> libraryHeaders) {
         libraryHeaders.add('CommonAPI/Types.hpp')
+        if (interfaceMetadata) {
+            libraryHeaders.add('cstdint')
+        }
         if (!fInterface.methods.filter[errors !== null].empty) {
             libraryHeaders.addAll('CommonAPI/InputStream.hpp', 'CommonAPI/OutputStream.hpp')
         }
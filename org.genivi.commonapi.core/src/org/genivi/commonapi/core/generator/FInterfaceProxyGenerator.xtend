@@ -28,12 +28,16 @@ class FInterfaceProxyGenerator {
         if(generateCode.equals("true")) {
             generateSyncCalls = FPreferences::getInstance.getPreference(PreferenceConstants::P_GENERATE_SYNC_CALLS, "true").equals("true")
             fileSystemAccess.generateFile(fInterface.proxyBaseHeaderPath, PreferenceConstants.P_OUTPUT_PROXIES, fInterface.generateProxyBaseHeader(deploymentAccessor, modelid))
-            fileSystemAccess.generateFile(fInterface.proxyHeaderPath, PreferenceConstants.P_OUTPUT_PROXIES, fInterface.generateProxyHeader(modelid))
+            fileSystemAccess.generateFile(fInterface.proxyHeaderPath, PreferenceConstants.P_OUTPUT_PROXIES, fInterface.generateProxyHeader(deploymentAccessor, modelid))
+            if (externProxyTemplates)
+                fileSystemAccess.generateFile(fInterface.proxySourcePath, PreferenceConstants.P_OUTPUT_PROXIES, fInterface.generateProxySource)
         }
         else {
             // feature: suppress code generation
             fileSystemAccess.generateFile(fInterface.proxyBaseHeaderPath, PreferenceConstants.P_OUTPUT_PROXIES, PreferenceConstants::NO_CODE)
             fileSystemAccess.generateFile(fInterface.proxyHeaderPath, PreferenceConstants.P_OUTPUT_PROXIES, PreferenceConstants::NO_CODE)
+            if (externProxyTemplates)
+                fileSystemAccess.generateFile(fInterface.proxySourcePath, PreferenceConstants.P_OUTPUT_PROXIES, PreferenceConstants::NO_CODE)
         }
     }
 
@@ -135,7 +139,7 @@ class FInterfaceProxyGenerator {
         #endif // «fInterface.defineName»_PROXY_BASE_HPP_
     '''
 
-    def private generateProxyHeader(FInterface fInterface, IResource modelid) '''
+    def private generateProxyHeader(FInterface fInterface, PropertyAccessor deploymentAccessor, IResource modelid) '''
         «generateCommonApiLicenseHeader()»
         «FTypeGenerator::generateComments(fInterface, false)»
         #ifndef «fInterface.defineName»_PROXY_HPP_
@@ -153,6 +157,10 @@ class FInterfaceProxyGenerator {
             #include <CommonAPI/AttributeExtension.hpp>
             #include <CommonAPI/Factory.hpp>
         «ENDIF»
+        «IF fInterface.methods.exists[isStreamed(deploymentAccessor)]»
+            #include <functional>
+            #include <memory>
+        «ENDIF»
 
         «endInternalCompilation»
 
@@ -250,6 +258,19 @@ class FInterfaceProxyGenerator {
                          */
                         virtual «itsElement.generateAsyncDefinition(true)»;
                     «ENDIF»
+                    «IF itsElement.isStreamed(deploymentAccessor)»
+                        typedef std::function<void(const «itsElement.outArgs.get(0).getTypeName(fInterface, true)» &)> «itsElement.proxyStreamChunkCallbackName»;
+                        typedef std::function<void(const CommonAPI::CallStatus &, uint64_t)> «itsElement.proxyStreamFinishedCallbackName»;
+                        /**
+                         * Receives the reply of «itsElement.elementName» in chunks of at most «itsElement.getReplyChunkSize(deploymentAccessor)» elements.
+                         *
+                         * «itsElement.elementName» is called with increasing «itsElement.streamOffsetArg.elementName» until a chunk shorter
+                         * than the chunk size arrives. Only one chunk is requested at a time. Each chunk is handed
+                         * to _chunk. Finally _finished is called with the CallStatus of the last call and the
+                         * number of received elements.
+                         */
+                        virtual void «itsElement.proxyStreamMethodName»(«itsElement.streamedInArgs.map['const ' + getTypeName(fInterface, true) + ' &_' + elementName + ', '].join»«itsElement.proxyStreamChunkCallbackName» _chunk, «itsElement.proxyStreamFinishedCallbackName» _finished, const CommonAPI::CallInfo *_info = nullptr);
+                    «ENDIF»
                 «ENDIF»
             «ENDFOR»
 
@@ -325,6 +346,9 @@ class FInterfaceProxyGenerator {
                         return delegate_->«itsElement.elementName»Async(«itsElement.generateASyncVariableList»);
                     }
                 «ENDIF»
+                «IF itsElement.isStreamed(deploymentAccessor)»
+                    «itsElement.generateStreamImplementation(fInterface, deploymentAccessor)»
+                «ENDIF»
             «ENDIF»
         «ENDFOR»
 
@@ -365,6 +389,11 @@ class FInterfaceProxyGenerator {
             return delegate_->getCompletionFuture();
         }
 
+        «IF externProxyTemplates»
+            // instantiated in «fInterface.proxySourceFile»
+            extern template class «fInterface.proxyClassName»<>;
+
+        «ENDIF»
         «fInterface.model.generateNamespaceEndDeclaration»
         «fInterface.generateVersionNamespaceEnd»
 
@@ -385,6 +414,20 @@ class FInterfaceProxyGenerator {
         #endif // «fInterface.defineName»_PROXY_HPP_
     '''
 
+    def private generateProxySource(FInterface fInterface) '''
+        «generateCommonApiLicenseHeader()»
+        «FTypeGenerator::generateComments(fInterface, false)»
+        #include "«fInterface.proxyHeaderFile»"
+
+        «fInterface.generateVersionNamespaceBegin»
+        «fInterface.model.generateNamespaceBeginDeclaration»
+
+        template class «fInterface.proxyClassName»<>;
+
+        «fInterface.model.generateNamespaceEndDeclaration»
+        «fInterface.generateVersionNamespaceEnd»
+    '''
+
     def private generateExtension(FAttribute fAttribute, FInterface fInterface) '''
         «FTypeGenerator::generateComments(fAttribute, false)»
         template <template <typename > class _ExtensionType>
@@ -407,6 +450,52 @@ class FInterfaceProxyGenerator {
         };
     '''
 
+    /**
+     * Generates the proxy side of a streamed reply: the method is called asynchronously with
+     * increasing offset, the next chunk is requested from the callback of the previous one.
+     */
+    def private generateStreamImplementation(FMethod fMethod, FInterface fInterface, PropertyAccessor deploymentAccessor) '''
+        «val itsChunkSize = fMethod.getReplyChunkSize(deploymentAccessor)»
+        «val itsOutType = fMethod.outArgs.get(0).getTypeName(fInterface, true)»
+        «val itsCaptures = fMethod.streamedInArgs.map[', _' + elementName].join»
+
+        template <typename ... _AttributeExtensions>
+        void «fInterface.proxyClassName»<_AttributeExtensions...>::«fMethod.proxyStreamMethodName»(«fMethod.streamedInArgs.map['const ' + getTypeName(fInterface, true) + ' &_' + elementName + ', '].join»«fMethod.proxyStreamChunkCallbackName» _chunk, «fMethod.proxyStreamFinishedCallbackName» _finished, const CommonAPI::CallInfo *_info) {
+            typedef std::function<void(uint64_t)> Request_t;
+            std::shared_ptr<Request_t> itsRequest = std::make_shared<Request_t>();
+            std::weak_ptr<Request_t> itsWeakRequest(itsRequest);
+            std::shared_ptr<CommonAPI::CallInfo> itsInfo;
+            if (_info)
+                itsInfo = std::make_shared<CommonAPI::CallInfo>(*_info);
+            std::shared_ptr< «fInterface.proxyBaseClassName»> itsDelegate(delegate_);
+
+            *itsRequest = [itsDelegate, itsWeakRequest, itsInfo, _chunk, _finished«itsCaptures»](uint64_t itsOffset) {
+                std::shared_ptr<Request_t> itsSelf = itsWeakRequest.lock();
+                if (!itsSelf)
+                    return;
+                itsDelegate->«fMethod.elementName»Async(«fMethod.streamedInArgs.map['_' + elementName + ', '].join»itsOffset,
+                    [itsSelf, _chunk, _finished, itsOffset](const CommonAPI::CallStatus &_status, const «itsOutType» &_elements) {
+                        if (_status != CommonAPI::CallStatus::SUCCESS) {
+                            if (_finished)
+                                _finished(_status, itsOffset);
+                            return;
+                        }
+                        if (!_elements.empty() && _chunk)
+                            _chunk(_elements);
+                        uint64_t itsNext = itsOffset + _elements.size();
+                        if (_elements.size() < «itsChunkSize») {
+                            if (_finished)
+                                _finished(_status, itsNext);
+                        } else {
+                            (*itsSelf)(itsNext);
+                        }
+                    },
+                    itsInfo.get());
+            };
+            (*itsRequest)(0);
+        }
+    '''
+
     def private generateAsyncCallbackTypedefs(FInterface fInterface) '''
         «var callbackDefinitions = new HashSet<String>()»
         «FOR fMethod : fInterface.methods»
@@ -15,6 +15,7 @@ import org.franca.core.franca.FBroadcast
 import org.franca.core.franca.FInterface
 import org.franca.core.franca.FMethod
 import org.genivi.commonapi.core.deployment.PropertyAccessor
+import org.genivi.commonapi.core.deployment.PropertyAccessor.StubDispatch
 import org.genivi.commonapi.core.preferences.FPreferences
 import org.genivi.commonapi.core.preferences.PreferenceConstants
 
@@ -22,17 +23,30 @@ class FInterfaceStubGenerator {
 	@Inject extension FTypeGenerator
 	@Inject extension FrancaGeneratorExtensions
 
-    var HashMap<String, Integer> counterMap;
-    var HashMap<FMethod, LinkedHashMap<String, Boolean>> methodrepliesMap;
+    // Interfaces may be generated in parallel, each thread keeps the replies of the current interface
+    val counterMap_ = new ThreadLocal<HashMap<String, Integer>>
+    val methodrepliesMap_ = new ThreadLocal<HashMap<FMethod, LinkedHashMap<String, Boolean>>>
+
+    def private getCounterMap() {
+        return counterMap_.get
+    }
+
+    def private getMethodrepliesMap() {
+        return methodrepliesMap_.get
+    }
 
     def generateStub(FInterface fInterface, IFileSystemAccess fileSystemAccess, PropertyAccessor deploymentAccessor, IResource modelid) {
 
         if(FPreferences::getInstance.getPreference(PreferenceConstants::P_GENERATE_CODE, "true").equals("true")) {
+            val stubMeasurement = GeneratorProfiler.start(GeneratorProfiler.ARTIFACT, GeneratorProfiler.STUB, fInterface.fullyQualifiedName)
             fileSystemAccess.generateFile(fInterface.stubHeaderPath, PreferenceConstants.P_OUTPUT_STUBS, fInterface.generateStubHeader(deploymentAccessor, modelid))
+            GeneratorProfiler.stop(stubMeasurement)
             // should skeleton code be generated ?
             if(FPreferences::instance.getPreference(PreferenceConstants::P_GENERATE_SKELETON, "false").equals("true"))
             {
+                val skeletonMeasurement = GeneratorProfiler.start(GeneratorProfiler.ARTIFACT, GeneratorProfiler.SKELETON, fInterface.fullyQualifiedName)
                 fileSystemAccess.generateFile(fInterface.stubDefaultHeaderPath, PreferenceConstants.P_OUTPUT_SKELETON, fInterface.generateStubDefaultHeader(deploymentAccessor, modelid))
+                GeneratorProfiler.stop(skeletonMeasurement)
             }
         }
         else {
@@ -52,8 +66,12 @@ class FInterfaceStubGenerator {
         #ifndef «fInterface.defineName»_STUB_HPP_
         #define «fInterface.defineName»_STUB_HPP_
 
-        #include <functional>
-        #include <sstream>
+        «IF !leanHeaders»
+            #include <functional>
+            #include <sstream>
+        «ELSEIF !fInterface.methods.empty»
+            #include <functional>
+        «ENDIF»
 
         «val generatedHeaders = new HashSet<String>»
         «val libraryHeaders = new HashSet<String>»
@@ -74,9 +92,19 @@ class FInterfaceStubGenerator {
             #include <«requiredHeaderFile»>
         «ENDFOR»
 
-        «IF !fInterface.attributes.empty»
+        «IF !fInterface.attributes.empty || fInterface.hasSelectiveBroadcasts || fInterface.hasDispatchedMethods(deploymentAccessor)»
             #include <mutex>
         «ENDIF»
+        «IF fInterface.hasDispatchedMethods(deploymentAccessor)»
+            #include <atomic>
+            #include <condition_variable>
+            #include <cstdint>
+            #include <deque>
+            #include <memory>
+            #include <thread>
+            #include <utility>
+            #include <vector>
+        «ENDIF»
 
         #include <CommonAPI/Stub.hpp>
 
@@ -154,10 +182,15 @@ class FInterfaceStubGenerator {
                 «ELSEIF itsElement instanceof FBroadcast»
                     «IF itsElement.selective»
                         std::shared_ptr<CommonAPI::ClientIdList> «itsElement.stubAdapterClassSubscriberListPropertyName»;
+                        std::mutex «itsElement.stubAdapterClassSubscriberMutexName»;
                     «ENDIF»
                 «ENDIF»
             «ENDFOR»
 
+            «FOR broadcast : fInterface.broadcasts.filter[selective]»
+                «broadcast.generateSubscriberRegistry»
+            «ENDFOR»
+
             «FOR attribute : fInterface.attributes»
             «ENDFOR»
         };
@@ -195,6 +228,10 @@ class FInterfaceStubGenerator {
             «ENDFOR»
         };
 
+        «IF fInterface.hasDispatchedMethods(deploymentAccessor)»
+            «fInterface.generateStubDispatcher»
+
+        «ENDIF»
         /**
          * Defines the interface that must be implemented by any class that should provide
          * the service «fInterface.elementName» to remote clients.
@@ -206,15 +243,21 @@ class FInterfaceStubGenerator {
               public virtual «fInterface.base.getTypeCollectionName(fInterface)»Stub«ENDIF»
         {
         public:
-        «{counterMap = new HashMap<String, Integer>();""}»
-        «{methodrepliesMap = new HashMap<FMethod, LinkedHashMap<String, Boolean>>();""}»
+        «{counterMap_.set(new HashMap<String, Integer>());""}»
+        «{methodrepliesMap_.set(new HashMap<FMethod, LinkedHashMap<String, Boolean>>());""}»
         «FOR method: fInterface.methods»
             «IF !method.isFireAndForget»
                 «generateMethodReplyDeclarations(deploymentAccessor, method, fInterface, counterMap, methodrepliesMap)»
             «ENDIF»
         «ENDFOR»
 
-            virtual ~«fInterface.stubClassName»() {}
+            «IF fInterface.hasDispatchedMethods(deploymentAccessor)»
+                virtual ~«fInterface.stubClassName»() {
+                    joinStubDispatcher();
+                }
+            «ELSE»
+                virtual ~«fInterface.stubClassName»() {}
+            «ENDIF»
             void lockInterfaceVersionAttribute(bool _lockAccess) { static_cast<void>(_lockAccess); }
             bool hasElement(const uint32_t _id) const {
                 «val itsSize = fInterface.rsize»
@@ -226,6 +269,11 @@ class FInterfaceStubGenerator {
                 «ENDIF»
             }
             virtual const CommonAPI::Version& getInterfaceVersion(std::shared_ptr<CommonAPI::ClientId> _client) = 0;
+            /// Provides the structural fingerprint of the interface in addition to its version
+            virtual uint32_t getInterfaceFingerprint(std::shared_ptr<CommonAPI::ClientId> _client) {
+                (void)_client;
+                return «fInterface.elementName»::getInterfaceFingerprint();
+            }
 
             «FOR itsElement : fInterface.elements»
                 «IF itsElement instanceof FAttribute»
@@ -257,7 +305,20 @@ class FInterfaceStubGenerator {
                     «IF (FTypeGenerator::isdeprecated(itsElement.comment))»
                         «{definition = " COMMONAPI_DEPRECATED";""}»
                     «ENDIF»
-                    virtual«definition» void «itsElement.elementName»(«generateOverloadedStubSignature(itsElement, methodrepliesMap.get(itsElement))») = 0;
+                    «IF itsElement.isDispatched(deploymentAccessor)»
+                        «val itsReplies = methodrepliesMap.get(itsElement)»
+                        «val itsOverloadError = itsElement.getOverloadError(deploymentAccessor)»
+                        virtual«definition» void «itsElement.elementName»(«generateOverloadedStubSignature(itsElement, itsReplies)») {
+                            «IF itsOverloadError !== null»if (!«ENDIF»getStubDispatcher()->«IF itsElement.getStubDispatch(deploymentAccessor) == StubDispatch::Serialized»postSerialized«ELSE»post«ENDIF»([this, «generateOverloadedStubArguments(itsElement, itsReplies)»]() {
+                                «itsElement.stubDispatchedMethodName»(«generateOverloadedStubArguments(itsElement, itsReplies)»);
+                            }«IF itsOverloadError !== null», true))
+                                «itsElement.generateOverloadErrorReply(itsOverloadError, deploymentAccessor)»;«ELSE»);«ENDIF»
+                        }
+                        /// This is the method that will be called by the stub dispatcher («itsElement.getStubDispatch(deploymentAccessor)») on remote calls on the method «itsElement.elementName».
+                        virtual«definition» void «itsElement.stubDispatchedMethodName»(«generateOverloadedStubSignature(itsElement, itsReplies)») = 0;
+                    «ELSE»
+                        virtual«definition» void «itsElement.elementName»(«generateOverloadedStubSignature(itsElement, methodrepliesMap.get(itsElement))») = 0;
+                    «ENDIF»
                 «ELSEIF itsElement instanceof FBroadcast»
                     «FTypeGenerator::generateComments(itsElement, false)»
                     «var definition = ""»
@@ -303,11 +364,17 @@ class FInterfaceStubGenerator {
 
             «FOR managed : fInterface.managedInterfaces»
                 virtual bool «managed.stubRegisterManagedMethodWithInstanceNumberImpl» {
-                    std::stringstream ss;
+                    «IF !leanHeaders»
+                        std::stringstream ss;
+                    «ENDIF»
                     auto stubAdapter = «fInterface.stubCommonAPIClassName»::stubAdapter_.lock();
                     if (stubAdapter) {
-                        ss << stubAdapter->getAddress().getInstance() << ".i" << _instanceNumber;
-                        std::string instance = ss.str();
+                        «IF leanHeaders»
+                            std::string instance = stubAdapter->getAddress().getInstance() + ".i" + std::to_string(_instanceNumber);
+                        «ELSE»
+                            ss << stubAdapter->getAddress().getInstance() << ".i" << _instanceNumber;
+                            std::string instance = ss.str();
+                        «ENDIF»
                         return stubAdapter->«managed.stubRegisterManagedName»(_stub, instance);
                     } else {
                         return false;
@@ -339,11 +406,116 @@ class FInterfaceStubGenerator {
                 }
             «ENDFOR»
 
+            «IF fInterface.hasDispatchedMethods(deploymentAccessor)»
+                /**
+                 * Replaces the stub dispatcher by one that uses the given number of worker threads.
+                 * The previous dispatcher completes the calls that were already dispatched before the
+                 * new one accepts calls, so that "Serialized" calls keep their order; calls arriving
+                 * meanwhile wait. Returns false without replacing the dispatcher if it is called by a
+                 * dispatched method, as its worker thread would have to wait for itself.
+                 */
+                bool setStubDispatcherWorkers(std::size_t _workers) {
+                    std::shared_ptr<«fInterface.stubDispatcherClassName»> itsDispatcher;
+                    {
+                        std::unique_lock<std::mutex> itsLock(stubDispatcherMutex_);
+                        if ((stubDispatcher_ && stubDispatcher_->isWorkerThread())
+                            || (drainingStubDispatcher_ && drainingStubDispatcher_->isWorkerThread()))
+                            return false;
+                        stubDispatcherReplaced_.wait(itsLock, [this]() { return !isReplacingStubDispatcher_; });
+                        isReplacingStubDispatcher_ = true;
+                        drainingStubDispatcher_ = stubDispatcher_;
+                        itsDispatcher = stubDispatcher_;
+                        stubDispatcher_.reset();
+                    }
+                    if (itsDispatcher)
+                        itsDispatcher->stop();
+                    {
+                        std::lock_guard<std::mutex> itsLock(stubDispatcherMutex_);
+                        stubDispatcher_ = std::make_shared<«fInterface.stubDispatcherClassName»>(_workers, stubQueueLimit_);
+                        drainingStubDispatcher_.reset();
+                        isReplacingStubDispatcher_ = false;
+                    }
+                    stubDispatcherReplaced_.notify_all();
+                    return true;
+                }
+                /**
+                 * Sets the maximum number of calls that may wait for a worker thread (0: no limit).
+                 * The default is taken from the deployment property StubQueueLimit.
+                 */
+                void setStubQueueLimit(std::size_t _limit) {
+                    std::lock_guard<std::mutex> itsLock(stubDispatcherMutex_);
+                    stubQueueLimit_ = _limit;
+                    if (stubDispatcher_)
+                        stubDispatcher_->setLimit(_limit);
+                }
+                /// Returns the queue depth and the admission counters of the stub dispatcher.
+                «fInterface.stubDispatcherClassName»::Statistics getStubDispatcherStatistics() {
+                    return getStubDispatcher()->getStatistics();
+                }
+                /**
+                 * Completes all dispatched calls and stops the worker threads. Calls arriving
+                 * afterwards are handled inline. The generated destructors stop the dispatcher, but
+                 * implementations that override the dispatched methods must call this in their own
+                 * destructor, as the worker threads may still call them. Returns false without
+                 * stopping if it is called by a dispatched method.
+                 */
+                bool stopStubDispatcher() {
+                    std::shared_ptr<«fInterface.stubDispatcherClassName»> itsDispatcher;
+                    {
+                        std::unique_lock<std::mutex> itsLock(stubDispatcherMutex_);
+                        if (drainingStubDispatcher_ && drainingStubDispatcher_->isWorkerThread())
+                            return false;
+                        stubDispatcherReplaced_.wait(itsLock, [this]() { return !isReplacingStubDispatcher_; });
+                        if (!stubDispatcher_)
+                            stubDispatcher_ = std::make_shared<«fInterface.stubDispatcherClassName»>(1, stubQueueLimit_);
+                        itsDispatcher = stubDispatcher_;
+                    }
+                    return itsDispatcher->stop();
+                }
+
+            «ENDIF»
             using «fInterface.stubCommonAPIClassName»::initStubAdapter;
             typedef «fInterface.stubCommonAPIClassName»::StubAdapterType StubAdapterType;
             typedef «fInterface.stubCommonAPIClassName»::RemoteEventHandlerType RemoteEventHandlerType;
             typedef «fInterface.stubRemoteEventClassName» RemoteEventType;
             typedef «fInterface.versionPrefix»«fInterface.model.generateCppNamespace»«fInterface.elementName» StubInterface;
+        «IF fInterface.hasDispatchedMethods(deploymentAccessor)»
+
+        protected:
+            /**
+             * While the dispatcher is replaced, calls wait until the previous dispatcher has
+             * completed its calls. Its own worker threads keep using it, they would wait for
+             * themselves; it executes their calls inline.
+             */
+            std::shared_ptr<«fInterface.stubDispatcherClassName»> getStubDispatcher() {
+                std::unique_lock<std::mutex> itsLock(stubDispatcherMutex_);
+                if (drainingStubDispatcher_ && drainingStubDispatcher_->isWorkerThread())
+                    return drainingStubDispatcher_;
+                stubDispatcherReplaced_.wait(itsLock, [this]() { return !isReplacingStubDispatcher_; });
+                if (!stubDispatcher_)
+                    stubDispatcher_ = std::make_shared<«fInterface.stubDispatcherClassName»>(std::thread::hardware_concurrency(), stubQueueLimit_);
+                return stubDispatcher_;
+            }
+
+            /// Completes all dispatched calls and joins the worker threads, if any were started.
+            void joinStubDispatcher() {
+                std::shared_ptr<«fInterface.stubDispatcherClassName»> itsDispatcher;
+                {
+                    std::lock_guard<std::mutex> itsLock(stubDispatcherMutex_);
+                    itsDispatcher = stubDispatcher_;
+                }
+                if (itsDispatcher)
+                    itsDispatcher->stop();
+            }
+
+        private:
+            std::shared_ptr<«fInterface.stubDispatcherClassName»> stubDispatcher_;
+            std::shared_ptr<«fInterface.stubDispatcherClassName»> drainingStubDispatcher_;
+            bool isReplacingStubDispatcher_ = false;
+            std::mutex stubDispatcherMutex_;
+            std::condition_variable stubDispatcherReplaced_;
+            std::size_t stubQueueLimit_ = «fInterface.getStubQueueLimit(deploymentAccessor)»;
+        «ENDIF»
         };
 
         «fInterface.model.generateNamespaceEndDeclaration»
@@ -396,6 +568,27 @@ class FInterfaceStubGenerator {
         #include <«fInterface.stubHeaderPath»>
         #include <cassert>
         #include <sstream>
+        «IF fInterface.methods.exists[isStreamed(deploymentAccessor)]»
+            #include <algorithm>
+        «ENDIF»
+        «IF fInterface.methods.exists[isCacheable(deploymentAccessor) || isStreamed(deploymentAccessor)]»
+            #include <cstdint>
+        «ENDIF»
+        «IF fInterface.methods.exists[isCacheable(deploymentAccessor)]»
+            #include <CommonAPI/Struct.hpp>
+            #include <CommonAPI/Types.hpp>
+            #include <CommonAPI/Variant.hpp>
+            #include <cstddef>
+            #include <functional>
+            #include <iterator>
+            #include <list>
+            #include <memory>
+            #include <mutex>
+            #include <tuple>
+            #include <type_traits>
+            #include <unordered_map>
+            #include <vector>
+        «ENDIF»
 
         # if defined(_MSC_VER)
         #  if _MSC_VER >= 1300
@@ -433,11 +626,119 @@ class FInterfaceStubGenerator {
                   «ENDIF»
                   interfaceVersion_(«fInterface.elementName»::getInterfaceVersion()) {
             }
+            «IF fInterface.hasDispatchedMethods(deploymentAccessor)»
+
+                COMMONAPI_EXPORT virtual ~«fInterface.stubDefaultClassName»() {
+                    // the default implementations of the dispatched methods use the members of this class
+                    joinStubDispatcher();
+                }
+            «ENDIF»
 
             COMMONAPI_EXPORT const CommonAPI::Version& getInterfaceVersion(std::shared_ptr<CommonAPI::ClientId> _client) {
                 (void)_client;
                 return interfaceVersion_;
             }
+            «IF fInterface.methods.exists[methodrepliesMap?.get(it) !== null && isCacheable(deploymentAccessor)]»
+
+                /// Hit and miss counters of a reply cache.
+                struct CacheStatistics {
+                    std::uint64_t hits_;
+                    std::uint64_t misses_;
+                };
+
+                /**
+                 * Hashes the input arguments of a reply cache. Structs are hashed over their members,
+                 * unions over their active element and arrays, maps and byte buffers over their
+                 * elements. Polymorphic structs are hashed by their serial and the members of their
+                 * static type; equal hashes are resolved by comparing the arguments.
+                 */
+                struct CacheHash {
+                    template<typename Type_>
+                    static std::size_t get(const Type_ &_value) {
+                        return get(_value, &_value);
+                    }
+                    template<typename... Types_>
+                    static std::size_t get(const std::tuple<Types_...> &_values) {
+                        return getMembers<0>(_values);
+                    }
+                    template<typename Element_, typename Allocator_>
+                    static std::size_t get(const std::vector<Element_, Allocator_> &_value) {
+                        std::size_t itsHash(_value.size());
+                        for (const auto &itsElement : _value)
+                            itsHash = combine(itsHash, get(static_cast<const Element_ &>(itsElement)));
+                        return itsHash;
+                    }
+                    template<typename Key_, typename Value_, typename Hasher_, typename Equal_, typename Allocator_>
+                    static std::size_t get(const std::unordered_map<Key_, Value_, Hasher_, Equal_, Allocator_> &_value) {
+                        // equal maps may iterate in different orders, so the entries are summed up
+                        std::size_t itsSum(0);
+                        for (const auto &itsEntry : _value)
+                            itsSum += combine(get(itsEntry.first), get(itsEntry.second));
+                        return combine(_value.size(), itsSum);
+                    }
+                    template<typename Type_>
+                    static std::size_t get(const std::shared_ptr<Type_> &_value) {
+                        return (_value ? get(*_value) : std::size_t(0));
+                    }
+
+                private:
+                    template<typename Type_, typename... Types_>
+                    static std::size_t get(const Type_ &, const CommonAPI::Struct<Types_...> *_struct) {
+                        return getMembers<0>(_struct->values_);
+                    }
+                    template<typename Type_>
+                    static std::size_t get(const Type_ &_value, const CommonAPI::PolymorphicStruct *) {
+                        return combine(std::hash<CommonAPI::Serial>()(_value.getSerial()), getOwnMembers(_value, 0));
+                    }
+                    template<typename Type_, typename... Types_>
+                    static std::size_t get(const Type_ &, const CommonAPI::Variant<Types_...> *_variant) {
+                        return combine(_variant->getValueType(), getElement<CommonAPI::Variant<Types_...>, Types_...>(*_variant));
+                    }
+                    template<typename Type_, typename Base_>
+                    static std::size_t get(const Type_ &, const CommonAPI::Enumeration<Base_> *_enumeration) {
+                        return std::hash<Base_>()(_enumeration->value_);
+                    }
+                    template<typename Type_>
+                    static std::size_t get(const Type_ &_value, const void *) {
+                        return std::hash<Type_>()(_value);
+                    }
+
+                    template<std::size_t Index_, typename... Types_>
+                    static typename std::enable_if<(Index_ < sizeof...(Types_)), std::size_t>::type
+                    getMembers(const std::tuple<Types_...> &_values) {
+                        return combine(get(std::get<Index_>(_values)), getMembers<Index_ + 1>(_values));
+                    }
+                    template<std::size_t Index_, typename... Types_>
+                    static typename std::enable_if<(Index_ == sizeof...(Types_)), std::size_t>::type
+                    getMembers(const std::tuple<Types_...> &) {
+                        return 0;
+                    }
+
+                    template<typename Type_>
+                    static auto getOwnMembers(const Type_ &_value, int) -> decltype((void)_value.values_, std::size_t()) {
+                        return getMembers<0>(_value.values_);
+                    }
+                    template<typename Type_>
+                    static std::size_t getOwnMembers(const Type_ &, long) {
+                        return 0;
+                    }
+
+                    template<typename Variant_>
+                    static std::size_t getElement(const Variant_ &) {
+                        return 0;
+                    }
+                    template<typename Variant_, typename Element_, typename... Elements_>
+                    static std::size_t getElement(const Variant_ &_variant) {
+                        return (_variant.template isType<Element_>()
+                                ? get(_variant.template get<Element_>())
+                                : getElement<Variant_, Elements_...>(_variant));
+                    }
+
+                    static std::size_t combine(std::size_t _seed, std::size_t _hash) {
+                        return _seed ^ (_hash + 0x9e3779b9 + (_seed << 6) + (_seed >> 2));
+                    }
+                };
+            «ENDIF»
 
             COMMONAPI_EXPORT «fInterface.stubRemoteEventClassName»* initStubAdapter(const std::shared_ptr< «fInterface.stubAdapterClassName»> &_adapter) {
                 «IF fInterface.base !== null»«fInterface.base.stubDefaultClassName»::initStubAdapter(_adapter);«ENDIF»
@@ -474,7 +775,15 @@ class FInterfaceStubGenerator {
                 «ELSEIF itsElement instanceof FMethod»
                     «var itsReplies = methodrepliesMap?.get(itsElement)»
                     «FTypeGenerator::generateComments(itsElement, false)»
-                    COMMONAPI_EXPORT virtual void «itsElement.elementName»(«generateOverloadedStubSignature(itsElement, methodrepliesMap?.get(itsElement))») {
+                    «val itsMethodName = if (itsElement.isDispatched(deploymentAccessor)) itsElement.stubDispatchedMethodName else itsElement.elementName»
+                    «IF itsReplies !== null && itsElement.isStreamed(deploymentAccessor)»
+                    «itsElement.generateStreamedMethod(itsMethodName, itsReplies, deploymentAccessor)»
+                    «ELSE»
+                    «IF itsReplies !== null && itsElement.isCacheable(deploymentAccessor)»
+                        «itsElement.generateCachedMethod(itsMethodName, itsReplies)»
+                        /// This is the method that will be called on remote calls on the method «itsElement.elementName» if the reply is not cached.
+                    «ENDIF»
+                    COMMONAPI_EXPORT virtual void «IF itsReplies !== null && itsElement.isCacheable(deploymentAccessor)»«itsElement.stubUncachedMethodName»«ELSE»«itsMethodName»«ENDIF»(«generateOverloadedStubSignature(itsElement, methodrepliesMap?.get(itsElement))») {
                         (void)_client;
                         «IF !itsElement.inArgs.empty»
                             «itsElement.inArgs.map['(void)_' + it.name].join(";\n")»;
@@ -501,6 +810,7 @@ class FInterfaceStubGenerator {
                             _reply(«itsElement.generateDummyArgumentList»);
                         «ENDIF»
                     }
+                    «ENDIF»
                 «ELSEIF itsElement instanceof FBroadcast»
                     «FTypeGenerator::generateComments(itsElement, false)»
                     «IF itsElement.selective»
@@ -639,6 +949,9 @@ class FInterfaceStubGenerator {
             «IF !fInterface.managedInterfaces.empty»
                 uint32_t autoInstanceCounter_;
             «ENDIF»
+            «FOR itsMethod : fInterface.methods.filter[methodrepliesMap?.get(it) !== null && isCacheable(deploymentAccessor)]»
+                «itsMethod.generateCacheMembers(methodrepliesMap.get(itsMethod), deploymentAccessor)»
+            «ENDFOR»
 
             «FOR attribute : fInterface.attributes»
                 «FTypeGenerator::generateComments(attribute, false)»
@@ -656,6 +969,578 @@ class FInterfaceStubGenerator {
         #endif // «getHeaderDefineName(fInterface)»
     '''
 
+    /**
+     * Generates the default implementation of a method whose reply is streamed (ReplyChunkSize).
+     * Each call requests one chunk: the application writes the elements starting at the requested
+     * offset through a generated writer, which refuses further elements once the chunk is full.
+     */
+    def private generateStreamedMethod(FMethod fMethod, String _methodName, LinkedHashMap<String, Boolean> _replies, PropertyAccessor _accessor) '''
+        «val itsName = _replies.entrySet.findFirst[!value].key»
+        «val itsWriter = itsName.stubChunkWriterClassName»
+        «val itsOutType = fMethod.outArgs.get(0).getTypeName(fMethod, true)»
+        /// Collects one chunk of the reply of the method «fMethod.elementName».
+        class «itsWriter» {
+        public:
+            typedef «itsOutType»::value_type Element_t;
+
+            «itsWriter»(uint64_t _offset, std::size_t _size)
+                : offset_(_offset), size_(_size) {
+                chunk_.reserve(_size);
+            }
+
+            /// Index of the first element of this chunk within the complete reply.
+            uint64_t getOffset() const {
+                return offset_;
+            }
+
+            /// Number of elements that still fit into this chunk.
+            std::size_t getCapacity() const {
+                return size_ - chunk_.size();
+            }
+
+            /// Appends an element. Returns false if the chunk is full.
+            bool write(const Element_t &_element) {
+                if (chunk_.size() >= size_)
+                    return false;
+                chunk_.push_back(_element);
+                return true;
+            }
+
+            /// Appends up to _count elements. Returns the number of elements that were written.
+            std::size_t write(const Element_t *_elements, std::size_t _count) {
+                std::size_t itsCount = std::min(_count, getCapacity());
+                chunk_.insert(chunk_.end(), _elements, _elements + itsCount);
+                return itsCount;
+            }
+
+            «itsOutType» &getChunk() {
+                return chunk_;
+            }
+
+        private:
+            uint64_t offset_;
+            std::size_t size_;
+            «itsOutType» chunk_;
+        };
+
+        COMMONAPI_EXPORT virtual void «_methodName»(«generateOverloadedStubSignature(fMethod, _replies)») {
+            «IF _replies.containsValue(true)»
+                (void)_call;
+                «FOR reply : _replies.entrySet.filter[value]»
+                    (void)_«reply.key»Reply;
+                «ENDFOR»
+            «ENDIF»
+            «itsWriter» itsWriter(_«fMethod.streamOffsetArg.elementName», «fMethod.getReplyChunkSize(_accessor)»);
+            «fMethod.stubStreamMethodName»(_client«fMethod.streamedInArgs.map[', _' + elementName].join», itsWriter);
+            _reply(itsWriter.getChunk());
+        }
+        /**
+         * This is the method that will be called on remote calls on the method «fMethod.elementName».
+         * Write the elements of the reply starting at _writer.getOffset() until the writer is full.
+         * A chunk that is not filled completely ends the reply.
+         */
+        COMMONAPI_EXPORT virtual void «fMethod.stubStreamMethodName»(const std::shared_ptr<CommonAPI::ClientId> _client«fMethod.streamedInArgs.map[', ' + getTypeName(fMethod, true) + ' _' + elementName].join», «itsWriter» &_writer) {
+            (void)_client;
+            «FOR arg : fMethod.streamedInArgs»
+                (void)_«arg.elementName»;
+            «ENDFOR»
+            (void)_writer;
+        }
+    '''
+
+    /**
+     * Generates the default implementation of a method that is deployed as "Cacheable". It replies
+     * from a least recently used cache keyed by the input arguments and calls the "Uncached" method
+     * on a miss. Replies that arrive after the cache was invalidated are not cached.
+     */
+    def private generateCachedMethod(FMethod fMethod, String _methodName, LinkedHashMap<String, Boolean> _replies) '''
+        «val itsName = _replies.entrySet.findFirst[!value].key»
+        «val itsValueTypes = fMethod.stubReplyTypes»
+        «val itsReplyArguments = fMethod.stubReplyArguments»
+        typedef std::tuple< «fMethod.inArgs.map[getTypeName(fMethod, true)].join(', ')» > «itsName»CacheKey_t;
+        typedef std::tuple< «itsValueTypes.join(', ')» > «itsName»CacheValue_t;
+
+        /// Replies to calls of the method «fMethod.elementName» from the cache or calls «fMethod.stubUncachedMethodName» and caches its reply.
+        COMMONAPI_EXPORT virtual void «_methodName»(«generateOverloadedStubSignature(fMethod, _replies)») {
+            «itsName»CacheKey_t itsKey(«fMethod.inArgs.map['_' + elementName].join(', ')»);
+            std::size_t itsHash = «itsName»CacheHash(itsKey);
+            «itsName»CacheValue_t itsValue;
+            std::uint64_t itsGeneration;
+            bool isCached(false);
+            {
+                std::lock_guard<std::mutex> itsLock(«itsName»CacheMutex_);
+                auto itsRange = «itsName»CacheIndex_.equal_range(itsHash);
+                for (auto it = itsRange.first; it != itsRange.second; ++it) {
+                    if (it->second->key_ == itsKey) {
+                        «itsName»Cache_.splice(«itsName»Cache_.begin(), «itsName»Cache_, it->second);
+                        itsValue = it->second->value_;
+                        isCached = true;
+                        break;
+                    }
+                }
+                if (isCached)
+                    «itsName»CacheStatistics_.hits_++;
+                else
+                    «itsName»CacheStatistics_.misses_++;
+                itsGeneration = «itsName»CacheGeneration_;
+            }
+            if (isCached) {
+                _reply(«FOR i : 0 ..< itsValueTypes.size SEPARATOR ', '»std::get<«i»>(itsValue)«ENDFOR»);
+                return;
+            }
+            «itsName»Reply_t itsReply = [this, itsHash, itsKey, itsGeneration, _reply](«fMethod.generateStubReplySignature») {
+                «itsName»CacheStore(itsHash, itsKey, «itsName»CacheValue_t(«itsReplyArguments.join(', ')»), itsGeneration);
+                _reply(«itsReplyArguments.join(', ')»);
+            };
+            «fMethod.stubUncachedMethodName»(«generateOverloadedStubArguments(fMethod, _replies).split(', ').map[if (it == '_reply') 'itsReply' else it].join(', ')»);
+        }
+        /// Drops all cached replies of the method «fMethod.elementName». Call this whenever the state the replies depend on changes.
+        COMMONAPI_EXPORT void «itsName.stubInvalidateCacheMethodName»() {
+            std::lock_guard<std::mutex> itsLock(«itsName»CacheMutex_);
+            «itsName»Cache_.clear();
+            «itsName»CacheIndex_.clear();
+            «itsName»CacheGeneration_++;
+        }
+        /// Sets the maximum number of cached replies of the method «fMethod.elementName» (0 disables the cache).
+        COMMONAPI_EXPORT void «itsName.stubCacheSizeMethodName»(std::size_t _size) {
+            std::lock_guard<std::mutex> itsLock(«itsName»CacheMutex_);
+            «itsName»CacheSize_ = _size;
+            «itsName»CacheEvict();
+        }
+        COMMONAPI_EXPORT CacheStatistics «itsName.stubCacheStatisticsMethodName»() {
+            std::lock_guard<std::mutex> itsLock(«itsName»CacheMutex_);
+            return «itsName»CacheStatistics_;
+        }
+    '''
+
+    def private generateCacheMembers(FMethod fMethod, LinkedHashMap<String, Boolean> _replies, PropertyAccessor _accessor) '''
+        «val itsName = _replies.entrySet.findFirst[!value].key»
+        «val itsEntry = itsName.toFirstUpper + 'CacheEntry'»
+        struct «itsEntry» {
+            std::size_t hash_;
+            «itsName»CacheKey_t key_;
+            «itsName»CacheValue_t value_;
+        };
+
+        static std::size_t «itsName»CacheHash(const «itsName»CacheKey_t &_key) {
+            return CacheHash::get(_key);
+        }
+
+        void «itsName»CacheStore(std::size_t _hash, const «itsName»CacheKey_t &_key, const «itsName»CacheValue_t &_value, std::uint64_t _generation) {
+            std::lock_guard<std::mutex> itsLock(«itsName»CacheMutex_);
+            if (_generation != «itsName»CacheGeneration_ || «itsName»CacheSize_ == 0)
+                return;
+            auto itsRange = «itsName»CacheIndex_.equal_range(_hash);
+            for (auto it = itsRange.first; it != itsRange.second; ++it) {
+                if (it->second->key_ == _key) {
+                    it->second->value_ = _value;
+                    «itsName»Cache_.splice(«itsName»Cache_.begin(), «itsName»Cache_, it->second);
+                    return;
+                }
+            }
+            «itsName»Cache_.push_front(«itsEntry»{ _hash, _key, _value });
+            «itsName»CacheIndex_.insert(std::make_pair(_hash, «itsName»Cache_.begin()));
+            «itsName»CacheEvict();
+        }
+
+        void «itsName»CacheEvict() {
+            while («itsName»Cache_.size() > «itsName»CacheSize_) {
+                auto itsLast = std::prev(«itsName»Cache_.end());
+                auto itsRange = «itsName»CacheIndex_.equal_range(itsLast->hash_);
+                for (auto it = itsRange.first; it != itsRange.second; ++it) {
+                    if (it->second == itsLast) {
+                        «itsName»CacheIndex_.erase(it);
+                        break;
+                    }
+                }
+                «itsName»Cache_.pop_back();
+            }
+        }
+
+        std::list<«itsEntry»> «itsName»Cache_;
+        std::unordered_multimap<std::size_t, std::list<«itsEntry»>::iterator> «itsName»CacheIndex_;
+        std::mutex «itsName»CacheMutex_;
+        std::size_t «itsName»CacheSize_ = «fMethod.getCacheSize(_accessor)»;
+        std::uint64_t «itsName»CacheGeneration_ = 0;
+        CacheStatistics «itsName»CacheStatistics_ = { 0, 0 };
+    '''
+
+    /**
+     * Generates the dispatcher that executes the methods deployed with StubDispatch "Serialized"
+     * or "Parallel". Each worker thread owns a deque of tasks and steals from the deques of the
+     * other workers only if its own deque is empty. The number of waiting tasks can be bounded
+     * (StubQueueLimit) to shed load on overload.
+     */
+    def private generateStubDispatcher(FInterface fInterface) '''
+        «val itsClassName = fInterface.stubDispatcherClassName»
+        /**
+         * Executes the calls of «fInterface.elementName» methods that are not dispatched inline on a pool
+         * of worker threads. Each worker owns a deque: it takes the oldest task of its own deque and
+         * steals the newest task of another worker only if its own deque is empty. Calls that arrive
+         * from outside are dealt to the deques round robin, tasks posted by a worker go to its own
+         * deque. Calls of "Serialized" methods are executed one after another, but never on the
+         * thread that delivered the message.
+         */
+        class «itsClassName» {
+        public:
+            /// Queue depth and admission counters.
+            struct Statistics {
+                std::size_t depth_;
+                std::size_t maxDepth_;
+                std::uint64_t accepted_;
+                std::uint64_t rejected_;
+                std::uint64_t throttled_;
+            };
+
+            «itsClassName»(std::size_t _workers, std::size_t _limit = 0)
+                : isRunning_(true), pending_(0), next_(0), sleeping_(0),
+                  limit_(_limit), depth_(0), maxDepth_(0), waiting_(0),
+                  accepted_(0), rejected_(0), throttled_(0),
+                  isSerializing_(false) {
+                if (_workers == 0)
+                    _workers = 1;
+                for (std::size_t i = 0; i < _workers; i++)
+                    queues_.push_back(std::make_shared<Queue>());
+                for (std::size_t i = 0; i < _workers; i++)
+                    workers_.push_back(std::thread(&«itsClassName»::run, this, i));
+            }
+
+            /// Must not be destroyed by one of its tasks.
+            ~«itsClassName»() {
+                stop();
+            }
+
+            /**
+             * Executes the given task on one of the worker threads. If the queue limit is reached,
+             * the task is rejected (returns false) if it is rejectable. Otherwise it is executed
+             * on the calling thread, which slows down the delivery of further calls.
+             */
+            bool post(std::function<void()> _task, bool _isRejectable = false) {
+                Admission itsAdmission = admit(_isRejectable, false);
+                if (itsAdmission == Admission::REJECTED)
+                    return false;
+                if (itsAdmission == Admission::QUEUED)
+                    enqueue(std::move(_task), true);
+                else
+                    _task();
+                return true;
+            }
+
+            /**
+             * Executes the given task after all serialized tasks that were posted before. If the
+             * queue limit is reached, the task is rejected (returns false) if it is rejectable.
+             * Otherwise the calling thread is blocked until a waiting task has been started, as
+             * running the task inline could overlap with the serialized task that is running.
+             * Must not be called by a serialized task.
+             */
+            bool postSerialized(std::function<void()> _task, bool _isRejectable = false) {
+                Admission itsAdmission = admit(_isRejectable, true);
+                if (itsAdmission == Admission::REJECTED)
+                    return false;
+                if (itsAdmission == Admission::INLINE) {
+                    _task();
+                    return true;
+                }
+                bool mustSchedule(false);
+                {
+                    std::lock_guard<std::mutex> itsLock(serializedMutex_);
+                    serialized_.push_back(std::move(_task));
+                    if (!isSerializing_) {
+                        isSerializing_ = true;
+                        mustSchedule = true;
+                    }
+                }
+                if (mustSchedule)
+                    enqueue(std::bind(&«itsClassName»::runSerialized, this), false);
+                return true;
+            }
+
+            /**
+             * Completes all posted tasks and joins the worker threads. Tasks posted afterwards are
+             * executed on the calling thread. Returns false without stopping if it is called by a
+             * task of this dispatcher, as its worker thread would have to join itself.
+             */
+            bool stop() {
+                if (isWorkerThread())
+                    return false;
+                std::lock_guard<std::mutex> itsStopLock(stopMutex_);
+                if (isRunning_.exchange(false)) {
+                    {
+                        std::lock_guard<std::mutex> itsLock(idleMutex_);
+                    }
+                    idle_.notify_all();
+                    {
+                        std::lock_guard<std::mutex> itsLock(spaceMutex_);
+                    }
+                    space_.notify_all();
+                    for (auto &itsWorker : workers_)
+                        itsWorker.join();
+                    // tasks that were posted while the workers finished are executed here
+                    for (auto &itsQueue : queues_) {
+                        std::deque<Task> itsTasks;
+                        {
+                            std::lock_guard<std::mutex> itsLock(itsQueue->mutex_);
+                            itsQueue->isClosed_ = true;
+                            itsTasks.swap(itsQueue->tasks_);
+                            pending_ -= itsTasks.size();
+                        }
+                        for (auto &itsTask : itsTasks)
+                            execute(itsTask);
+                    }
+                }
+                return true;
+            }
+
+            /// Returns true if the calling thread is one of the worker threads.
+            bool isWorkerThread() const {
+                return (getCurrentWorker().first == this);
+            }
+
+            std::size_t getWorkerCount() const {
+                return workers_.size();
+            }
+
+            /// Sets the maximum number of waiting tasks (0: no limit).
+            void setLimit(std::size_t _limit) {
+                limit_ = _limit;
+                {
+                    std::lock_guard<std::mutex> itsLock(spaceMutex_);
+                }
+                space_.notify_all();
+            }
+
+            Statistics getStatistics() const {
+                return Statistics{ depth_, maxDepth_, accepted_, rejected_, throttled_ };
+            }
+
+        private:
+            enum class Admission { QUEUED, INLINE, REJECTED };
+
+            struct Task {
+                std::function<void()> function_;
+                bool isCounted_;
+            };
+
+            struct Queue {
+                Queue() : isClosed_(false) {}
+                std::mutex mutex_;
+                std::deque<Task> tasks_;
+                bool isClosed_;
+            };
+
+            /// The dispatcher and the index of the worker that runs on the calling thread.
+            static std::pair<const void *, std::size_t> &getCurrentWorker() {
+                static thread_local std::pair<const void *, std::size_t> itsCurrentWorker(nullptr, 0);
+                return itsCurrentWorker;
+            }
+
+            Admission admit(bool _isRejectable, bool _mustWait) {
+                bool isThrottled(false);
+                while (isRunning_) {
+                    std::size_t itsLimit = limit_;
+                    std::size_t itsDepth = depth_;
+                    if (itsLimit == 0 || itsDepth < itsLimit) {
+                        if (!depth_.compare_exchange_weak(itsDepth, itsDepth + 1))
+                            continue;
+                        accepted_++;
+                        std::size_t itsMaxDepth = maxDepth_;
+                        while (itsDepth + 1 > itsMaxDepth && !maxDepth_.compare_exchange_weak(itsMaxDepth, itsDepth + 1))
+                            ;
+                        return Admission::QUEUED;
+                    }
+                    if (_isRejectable) {
+                        rejected_++;
+                        return Admission::REJECTED;
+                    }
+                    if (!isThrottled) {
+                        isThrottled = true;
+                        throttled_++;
+                    }
+                    if (!_mustWait)
+                        return Admission::INLINE;
+                    std::unique_lock<std::mutex> itsLock(spaceMutex_);
+                    waiting_++;
+                    space_.wait(itsLock, [this]() { return (limit_ == 0 || depth_ < limit_ || !isRunning_); });
+                    waiting_--;
+                }
+                return Admission::INLINE;
+            }
+
+            void enqueue(std::function<void()> _task, bool _isCounted) {
+                const std::pair<const void *, std::size_t> &itsWorker = getCurrentWorker();
+                Queue &itsQueue = *queues_[itsWorker.first == this ? itsWorker.second : next_++ % queues_.size()];
+                Task itsTask{ std::move(_task), _isCounted };
+                {
+                    std::lock_guard<std::mutex> itsLock(itsQueue.mutex_);
+                    if (!itsQueue.isClosed_) {
+                        itsQueue.tasks_.push_back(std::move(itsTask));
+                        pending_++;
+                        itsTask.function_ = nullptr;
+                    }
+                }
+                if (itsTask.function_) {
+                    execute(itsTask);
+                } else if (sleeping_ > 0) {
+                    {
+                        std::lock_guard<std::mutex> itsLock(idleMutex_);
+                    }
+                    idle_.notify_one();
+                }
+            }
+
+            void leave() {
+                depth_--;
+                if (waiting_ > 0) {
+                    {
+                        std::lock_guard<std::mutex> itsLock(spaceMutex_);
+                    }
+                    space_.notify_one();
+                }
+            }
+
+            void execute(Task &_task) {
+                if (_task.isCounted_)
+                    leave();
+                _task.function_();
+                _task.function_ = nullptr;
+            }
+
+            bool take(std::size_t _index, Task &_task) {
+                {
+                    Queue &itsQueue = *queues_[_index];
+                    std::lock_guard<std::mutex> itsLock(itsQueue.mutex_);
+                    if (!itsQueue.tasks_.empty()) {
+                        _task = std::move(itsQueue.tasks_.front());
+                        itsQueue.tasks_.pop_front();
+                        pending_--;
+                        return true;
+                    }
+                }
+                // the own deque is empty: steal the newest task of another worker
+                for (std::size_t i = 1; i < queues_.size(); i++) {
+                    Queue &itsQueue = *queues_[(_index + i) % queues_.size()];
+                    std::lock_guard<std::mutex> itsLock(itsQueue.mutex_);
+                    if (!itsQueue.tasks_.empty()) {
+                        _task = std::move(itsQueue.tasks_.back());
+                        itsQueue.tasks_.pop_back();
+                        pending_--;
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            void run(std::size_t _index) {
+                getCurrentWorker() = std::make_pair(static_cast<const void *>(this), _index);
+                Task itsTask;
+                while (true) {
+                    if (take(_index, itsTask)) {
+                        execute(itsTask);
+                        continue;
+                    }
+                    std::unique_lock<std::mutex> itsLock(idleMutex_);
+                    sleeping_++;
+                    idle_.wait(itsLock, [this]() { return (pending_ > 0 || !isRunning_); });
+                    sleeping_--;
+                    if (!isRunning_ && pending_ == 0)
+                        break;
+                }
+                getCurrentWorker() = std::make_pair(static_cast<const void *>(nullptr), std::size_t(0));
+            }
+
+            void runSerialized() {
+                std::function<void()> itsTask;
+                while (true) {
+                    {
+                        std::lock_guard<std::mutex> itsLock(serializedMutex_);
+                        if (serialized_.empty()) {
+                            isSerializing_ = false;
+                            return;
+                        }
+                        itsTask = std::move(serialized_.front());
+                        serialized_.pop_front();
+                    }
+                    leave();
+                    itsTask();
+                }
+            }
+
+            std::atomic<bool> isRunning_;
+            std::atomic<std::size_t> pending_;
+            std::atomic<std::size_t> next_;
+            std::atomic<std::size_t> sleeping_;
+            std::vector<std::shared_ptr<Queue>> queues_;
+            std::vector<std::thread> workers_;
+            std::mutex idleMutex_;
+            std::condition_variable idle_;
+            std::mutex stopMutex_;
+
+            std::atomic<std::size_t> limit_;
+            std::atomic<std::size_t> depth_;
+            std::atomic<std::size_t> maxDepth_;
+            std::atomic<std::size_t> waiting_;
+            std::atomic<std::uint64_t> accepted_;
+            std::atomic<std::uint64_t> rejected_;
+            std::atomic<std::uint64_t> throttled_;
+            std::mutex spaceMutex_;
+            std::condition_variable space_;
+
+            std::mutex serializedMutex_;
+            std::deque<std::function<void()>> serialized_;
+            bool isSerializing_;
+        };
+    '''
+
+    /**
+     * Generates the subscriber registry of a selective broadcast. The subscriber list is
+     * only copied if a snapshot that was handed out before is still referenced (copy-on-write).
+     * Otherwise it is modified in place, so (un)subscribing a client is O(1).
+     */
+    def private generateSubscriberRegistry(FBroadcast fBroadcast) '''
+        «val itsList = fBroadcast.stubAdapterClassSubscriberListPropertyName»
+        «val itsMutex = fBroadcast.stubAdapterClassSubscriberMutexName»
+        /// Adds a subscriber for «fBroadcast.elementName». Returns false if the client is already subscribed.
+        bool «fBroadcast.stubAdapterClassAddSubscriberMethodName»(const std::shared_ptr<CommonAPI::ClientId> &_client) {
+            std::lock_guard<std::mutex> itsLock(«itsMutex»);
+            if (!«itsList») {
+                «itsList» = std::make_shared<CommonAPI::ClientIdList>();
+            } else if («itsList»->find(_client) != «itsList»->end()) {
+                return false;
+            } else if («itsList».use_count() > 1) {
+                «itsList» = std::make_shared<CommonAPI::ClientIdList>(*«itsList»);
+            }
+            return «itsList»->insert(_client).second;
+        }
+        /// Removes a subscriber for «fBroadcast.elementName». Returns false if the client was not subscribed.
+        bool «fBroadcast.stubAdapterClassRemoveSubscriberMethodName»(const std::shared_ptr<CommonAPI::ClientId> &_client) {
+            std::lock_guard<std::mutex> itsLock(«itsMutex»);
+            if (!«itsList» || «itsList»->find(_client) == «itsList»->end()) {
+                return false;
+            }
+            if («itsList».use_count() > 1) {
+                «itsList» = std::make_shared<CommonAPI::ClientIdList>(*«itsList»);
+            }
+            return («itsList»->erase(_client) > 0);
+        }
+        /// Checks whether the given client is subscribed for «fBroadcast.elementName».
+        bool «fBroadcast.stubAdapterClassHasSubscriberMethodName»(const std::shared_ptr<CommonAPI::ClientId> &_client) {
+            std::lock_guard<std::mutex> itsLock(«itsMutex»);
+            return («itsList» && «itsList»->find(_client) != «itsList»->end());
+        }
+        /**
+         * Returns the subscribers for «fBroadcast.elementName» without copying them.
+         * The returned list is an immutable snapshot, later (un)subscriptions copy the list
+         * as long as the snapshot is referenced.
+         */
+        std::shared_ptr<const CommonAPI::ClientIdList> «fBroadcast.stubAdapterClassSubscriberSnapshotMethodName»() {
+            std::lock_guard<std::mutex> itsLock(«itsMutex»);
+            if (!«itsList») {
+                «itsList» = std::make_shared<CommonAPI::ClientIdList>();
+            }
+            return «itsList»;
+        }
+    '''
+
     def private getStubDefaultClassSetMethodName(FAttribute fAttribute) {
         'set' + fAttribute.elementName.toFirstUpper + 'Attribute'
     }
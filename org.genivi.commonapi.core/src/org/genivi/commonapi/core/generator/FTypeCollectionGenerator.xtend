@@ -31,6 +31,9 @@ class FTypeCollectionGenerator {
             if (fTypeCollection.hasSourceFile) {
                 fileSystemAccess.generateFile(fTypeCollection.sourcePath, IFileSystemAccess.DEFAULT_OUTPUT, fTypeCollection.generateSource(modelid, deploymentAccessor))
             }
+            if (leanHeaders) {
+                fileSystemAccess.generateFile(fTypeCollection.fwdHeaderPath, IFileSystemAccess.DEFAULT_OUTPUT, fTypeCollection.generateFwdHeader)
+            }
         }
         else {
             // feature: suppress code generation
@@ -39,9 +42,33 @@ class FTypeCollectionGenerator {
             if (fTypeCollection.hasSourceFile) {
                 fileSystemAccess.generateFile(fTypeCollection.sourcePath, IFileSystemAccess.DEFAULT_OUTPUT, PreferenceConstants::NO_CODE)
             }
+            if (leanHeaders) {
+                fileSystemAccess.generateFile(fTypeCollection.fwdHeaderPath, IFileSystemAccess.DEFAULT_OUTPUT, PreferenceConstants::NO_CODE)
+            }
         }
     }
 
+    /**
+     * Declares the type collection. The types are nested in the type collection, they can
+     * not be declared without it.
+     */
+    def private generateFwdHeader(FTypeCollection fTypeCollection) '''
+        «generateCommonApiLicenseHeader()»
+        «FTypeGenerator::generateComments(fTypeCollection, false)»
+        #ifndef «fTypeCollection.defineName»_FWD_HPP_
+        #define «fTypeCollection.defineName»_FWD_HPP_
+
+        «fTypeCollection.generateVersionNamespaceBegin»
+        «fTypeCollection.model.generateNamespaceBeginDeclaration»
+
+        struct «fTypeCollection.elementName»;
+
+        «fTypeCollection.model.generateNamespaceEndDeclaration»
+        «fTypeCollection.generateVersionNamespaceEnd»
+
+        #endif // «fTypeCollection.defineName»_FWD_HPP_
+    '''
+
     def private generateHeader(FTypeCollection fTypeCollection, IResource modelid, PropertyAccessor deploymentAccessor) '''
         «generateCommonApiLicenseHeader()»
         «FTypeGenerator::generateComments(fTypeCollection, false)»
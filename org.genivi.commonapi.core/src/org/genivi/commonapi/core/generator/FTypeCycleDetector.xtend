@@ -4,8 +4,11 @@
    file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 package org.genivi.commonapi.core.generator
 
+import java.util.ArrayList
 import java.util.HashMap
+import java.util.HashSet
 import java.util.List
+import java.util.Set
 import java.util.Stack
 import org.franca.core.franca.FType
 import javax.inject.Inject
@@ -17,8 +20,12 @@ class FTypeCycleDetector {
     val indices = new HashMap<FType, Integer>
 	val lowlink = new HashMap<FType, Integer>
 	val stack = new Stack<FType>
+	val onStack = new HashSet<FType>
 	var int index
+    // the type graph, shared by the cycle detection and the topological sort
+    val referencedTypes = new HashMap<FType, List<FType>>
     public var String outErrorString
+    val errorPath = new StringBuilder
 
     new(FrancaGeneratorExtensions francaGeneratorExtensions) {
         this.francaGeneratorExtensions = francaGeneratorExtensions
@@ -31,22 +38,69 @@ class FTypeCycleDetector {
         indices.clear()
         lowlink.clear()
         stack.clear()
+        onStack.clear()
         index = 0
-        outErrorString = type.elementName + "->";
-        return tarjan(type)
+        errorPath.setLength(0)
+        errorPath.append(type.elementName + "->")
+        val hasCycle = tarjan(type)
+        outErrorString = errorPath.toString
+        return hasCycle
     }
 
     def dispatch boolean hasCycle(List<FType> types) {
         indices.clear()
         lowlink.clear()
         stack.clear()
+        onStack.clear()
         index = 0
+        errorPath.setLength(0)
 
         val typeWithCycle = types.findFirst[type|!indices.containsKey(type) && tarjan(type)]
 
+        outErrorString = errorPath.toString
         return typeWithCycle !== null
     }
 
+    /**
+     * Sorts the types such that each type follows all types it references (transitively).
+     * Apart from that, the order of the given list is kept. The types must not contain a cycle.
+     *
+     * @param types
+     *            the types to sort.
+     * @return the sorted types.
+     */
+    def List<FType> sortTypes(List<FType> types) {
+        val sortedTypes = new ArrayList<FType>(types.size)
+        val typesToSort = new HashSet<FType>(types)
+        val visited = new HashSet<FType>
+
+        for (type : types) {
+            type.addSorted(typesToSort, visited, sortedTypes)
+        }
+        return sortedTypes
+    }
+
+    // depth first search, a type is added after all types it references
+    def private void addSorted(FType type, Set<FType> typesToSort, Set<FType> visited, List<FType> sortedTypes) {
+        if (!visited.add(type))
+            return
+
+        for (referencedType : type.referencedTypes) {
+            referencedType.addSorted(typesToSort, visited, sortedTypes)
+        }
+        if (typesToSort.contains(type))
+            sortedTypes.add(type)
+    }
+
+    def private List<FType> getReferencedTypes(FType type) {
+        var types = referencedTypes.get(type)
+        if (types === null) {
+            types = type.directlyReferencedTypes
+            referencedTypes.put(type, types)
+        }
+        return types
+    }
+
     // Tarjan's Strongly Connected Components Algorithm
     // returns true if a cycle was detected
     /**
@@ -62,11 +116,10 @@ class FTypeCycleDetector {
         index = index + 1
 
         stack.push(type)
+        onStack.add(type)
 
-        val directlyReferencedTypes = type.directlyReferencedTypes
-
-        for (referencedType : directlyReferencedTypes) {
-            outErrorString = outErrorString + referencedType.elementName + "->"
+        for (referencedType : type.referencedTypes) {
+            errorPath.append(referencedType.elementName + "->")
             if (!indices.containsKey(referencedType)) {
                 if (tarjan(referencedType))
                     return true
@@ -75,7 +128,7 @@ class FTypeCycleDetector {
                     type,
                     Math::min(lowlink.get(type), lowlink.get(referencedType))
                 );
-            } else if (stack.contains(referencedType))
+            } else if (onStack.contains(referencedType))
                 lowlink.put(
                     type,
                     Math::min(lowlink.get(type), indices.get(referencedType))
@@ -83,9 +136,13 @@ class FTypeCycleDetector {
         }
 
         // if scc root and not on top of stack, then we have a cycle (scc size > 1)
-        if (lowlink.get(type) == indices.get(type) && !stack.pop().equals(type)) {
-            outErrorString = outErrorString.subSequence(0, outErrorString.length - 2) as String
-            return true;
+        if (lowlink.get(type) == indices.get(type)) {
+            val root = stack.pop()
+            onStack.remove(root)
+            if (!root.equals(type)) {
+                errorPath.setLength(errorPath.length - 2)
+                return true;
+            }
         }
 
         return false
@@ -6,7 +6,6 @@ package org.genivi.commonapi.core.generator
 
 import java.util.Collection
 import java.util.HashSet
-import java.util.LinkedList
 import java.util.List
 import java.util.Set
 import javax.inject.Inject
@@ -120,34 +119,196 @@ class FTypeGenerator {
                 «method.errors.generateDeclaration(method.errors, deploymentAccessor)»
             «ENDFOR»
         «ENDIF»
+        «IF serializedSize && fTypeCollection.types.exists[hasSerializedSizeFunction]»
+
+            /// Returns the size of a serialized union, array, map or polymorphic struct (std::shared_ptr),
+            /// computed by the size stream _Sizer of a binding.
+            template<class _Sizer, class _Type, class _Deployment>
+            static std::size_t serializedSize(const _Type &_value, const _Deployment *_depl) {
+                _Sizer its_sizer;
+                its_sizer.writeValue(_value, _depl);
+                return its_sizer.getSize();
+            }
+        «ENDIF»
     '''
 
-    def private sortTypes(EList<FType> typeList, FTypeCollection containingTypeCollection) {
-        checkArgument(typeList.hasNoCircularDependencies, 'FTypeCollection or FInterface has circular dependencies: ' + containingTypeCollection)
-        var List<FType> sortedTypeList = new LinkedList<FType>()
-        for(currentType: typeList) {
-            var insertIndex = 0
-            while(insertIndex < sortedTypeList.size && !currentType.isReferencedBy(sortedTypeList.get(insertIndex))) {
-                insertIndex = insertIndex + 1
-            }
-            sortedTypeList.add(insertIndex, currentType)
-        }
-        return sortedTypeList
-    }
+    def private generateTrivialStructDeclaration(FStructType fStructType) '''
+        «val dataName = fStructType.elementName + "Data"»
+        /// Trivially copyable representation of «fStructType.elementName». Its layout has no padding and
+        /// equals the packed serialized layout, so arrays are copied with memcpy and a byte swap.
+        /// Booleans are stored as uint8_t. It is an application-level bulk copy, not a serialization
+        /// path: the generated serialization does not use it, the application converts with getData().
+        struct «dataName» {
+            «FOR element : fStructType.allElements»
+                «element.type.trivialTypeName» «element.elementName»;
+            «ENDFOR»
+
+            /// Copies _count elements to _buffer, swaps the byte order of the members if _swap is set.
+            static void write(const «dataName» *_data, std::size_t _count, uint8_t *_buffer, bool _swap) {
+                std::memcpy(_buffer, _data, _count * sizeof(«dataName»));
+                if (_swap)
+                    swap(_buffer, _count);
+            }
+            /// Copies _count elements from _buffer, swaps the byte order of the members if _swap is set.
+            static void read(const uint8_t *_buffer, std::size_t _count, «dataName» *_data, bool _swap) {
+                std::memcpy(_data, _buffer, _count * sizeof(«dataName»));
+                if (_swap)
+                    swap(reinterpret_cast<uint8_t *>(_data), _count);
+            }
+            «IF fStructType.allElements.exists[type.trivialSize == 2]»
+                static void swapMember(uint8_t *_member, uint16_t) {
+                    uint16_t its_value;
+                    std::memcpy(&its_value, _member, sizeof(its_value));
+                    its_value = static_cast<uint16_t>((its_value >> 8) | (its_value << 8));
+                    std::memcpy(_member, &its_value, sizeof(its_value));
+                }
+            «ENDIF»
+            «IF fStructType.allElements.exists[type.trivialSize == 4]»
+                static void swapMember(uint8_t *_member, uint32_t) {
+                    uint32_t its_value;
+                    std::memcpy(&its_value, _member, sizeof(its_value));
+                    its_value = (its_value >> 24) | ((its_value >> 8) & 0xFF00u) | ((its_value << 8) & 0xFF0000u) | (its_value << 24);
+                    std::memcpy(_member, &its_value, sizeof(its_value));
+                }
+            «ENDIF»
+            «IF fStructType.allElements.exists[type.trivialSize == 8]»
+                static void swapMember(uint8_t *_member, uint64_t) {
+                    uint64_t its_value;
+                    std::memcpy(&its_value, _member, sizeof(its_value));
+                    its_value = (its_value >> 56) | ((its_value >> 40) & 0xFF00ull) | ((its_value >> 24) & 0xFF0000ull)
+                        | ((its_value >> 8) & 0xFF000000ull) | ((its_value << 8) & 0xFF00000000ull)
+                        | ((its_value << 24) & 0xFF0000000000ull) | ((its_value << 40) & 0xFF000000000000ull) | (its_value << 56);
+                    std::memcpy(_member, &its_value, sizeof(its_value));
+                }
+            «ENDIF»
+            /// Swaps the byte order of the members of _count elements in place.
+            static void swap(uint8_t *_buffer, std::size_t _count) {
+                «IF fStructType.allElements.exists[type.trivialSize > 1]»
+                    for (std::size_t i = 0; i < _count; ++i) {
+                        uint8_t *its_element = _buffer + i * sizeof(«dataName»);
+                        «var swapOffset = 0»
+                        «FOR element : fStructType.allElements»
+                            «IF element.type.trivialSize > 1»
+                                swapMember(its_element + «swapOffset», uint«element.type.trivialSize * 8»_t());
+                            «ENDIF»
+                            «{ swapOffset = swapOffset + element.type.trivialSize; "" }»
+                        «ENDFOR»
+                    }
+                «ELSE»
+                    (void) _buffer;
+                    (void) _count;
+                «ENDIF»
+            }
+        };
+        static_assert(std::is_standard_layout< «dataName»>::value, "«dataName» must have standard layout");
+        static_assert(std::is_trivially_copyable< «dataName»>::value, "«dataName» must be trivially copyable");
+        static_assert(sizeof(«dataName») == «fStructType.packedSize», "«dataName» must not contain padding");
+        «var offset = 0»
+        «FOR element : fStructType.allElements»
+            static_assert(offsetof(«dataName», «element.elementName») == «offset», "unexpected offset of «dataName»::«element.elementName»");
+            «{ offset = offset + element.type.trivialSize; "" }»
+        «ENDFOR»
+    '''
+
+    def private generatePackedBooleansStructDeclaration(FStructType fStructType) '''
+        «val structName = fStructType.elementName»
+        «val packedName = fStructType.packedBooleansStructName»
+        «val packedType = fStructType.packedBooleansType.primitiveTypeName»
+        /// «structName» with its Boolean members stored as the bits of one «packedType». It is read and
+        /// written member by member with the Boolean members expanded, i.e. its serialized form and its
+        /// deployment equal the ones of «structName».
+        struct «packedName» {
+            «packedName»() : «packedName»(«structName»()) {
+            }
+            explicit «packedName»(const «structName» &_value) : values_() {
+                «FOR element : fStructType.allElements»
+                    set«element.elementName.toFirstUpper»(_value.get«element.elementName.toFirstUpper»());
+                «ENDFOR»
+            }
+            inline «structName» getValue() const {
+                return «structName»(«fStructType.allElements.map["get" + elementName.toFirstUpper + "()"].join(", ")»);
+            }
+
+            template<class _Input>
+            void readValue(CommonAPI::InputStream<_Input> &_input, const CommonAPI::EmptyDeployment *_depl) {
+                (void) _depl;
+                bool its_value(false);
+                «FOR element : fStructType.allElements»
+                    «IF element.packableBoolean»
+                        _input.template readValue<CommonAPI::EmptyDeployment>(its_value);
+                        set«element.elementName.toFirstUpper»(its_value);
+                    «ELSE»
+                        _input.template readValue<CommonAPI::EmptyDeployment>(std::get< «fStructType.getTupleIndex(element, true)»>(values_));
+                    «ENDIF»
+                «ENDFOR»
+            }
+            template<class _Input, class _Deployment>
+            void readValue(CommonAPI::InputStream<_Input> &_input, const _Deployment *_depl) {
+                bool its_value(false);
+                «var i = -1»
+                «FOR element : fStructType.allElements»
+                    «IF element.packableBoolean»
+                        _input.template readValue<>(its_value, std::get< «i = i+1»>(_depl->values_));
+                        set«element.elementName.toFirstUpper»(its_value);
+                    «ELSE»
+                        _input.template readValue<>(std::get< «fStructType.getTupleIndex(element, true)»>(values_), std::get< «i = i+1»>(_depl->values_));
+                    «ENDIF»
+                «ENDFOR»
+            }
+            template<class _Output>
+            void writeValue(CommonAPI::OutputStream<_Output> &_output, const CommonAPI::EmptyDeployment *_depl) const {
+                (void) _depl;
+                «FOR element : fStructType.allElements»
+                    _output.template writeValue<CommonAPI::EmptyDeployment>(get«element.elementName.toFirstUpper»());
+                «ENDFOR»
+            }
+            template<class _Output, class _Deployment>
+            void writeValue(CommonAPI::OutputStream<_Output> &_output, const _Deployment *_depl) const {
+                «var j = -1»
+                «FOR element : fStructType.allElements»
+                    _output.template writeValue<>(get«element.elementName.toFirstUpper»(), std::get< «j = j+1»>(_depl->values_));
+                «ENDFOR»
+            }
+
+            «FOR element : fStructType.allElements»
+                «val String typeName = element.getTypeName(fStructType, false)»
+                «val int k = fStructType.getTupleIndex(element, true)»
+                «IF element.packableBoolean»
+                    «val String mask = fStructType.getPackedBooleanMask(element)»
+                    inline bool get«element.elementName.toFirstUpper»() const { return ((std::get< «k»>(values_) & «mask») != 0); }
+                    inline void set«element.elementName.toFirstUpper»(const bool _value) { if (_value) std::get< «k»>(values_) |= «mask»; else std::get< «k»>(values_) &= static_cast< «packedType»>(~«mask»); }
+                «ELSE»
+                    inline const «typeName» &get«element.elementName.toFirstUpper»() const { return std::get< «k»>(values_); }
+                    inline void set«element.elementName.toFirstUpper»(const «typeName» «IF typeName.isComplex»&«ENDIF»_value) { std::get< «k»>(values_) = _value; }
+                «ENDIF»
+            «ENDFOR»
+
+            inline bool operator==(const «packedName» &_other) const {
+                return values_ == _other.values_;
+            }
+            inline bool operator!=(const «packedName» &_other) const {
+                return !((*this) == _other);
+            }
+
+            std::tuple< «fStructType.getTupleTypeNames(true).join(", ")»> values_;
+        };
+    '''
 
-    def private isReferencedBy(FType lhs, FType rhs) {
-        return rhs.referencedTypes.contains(lhs)
+    def private generateMakeShared(String _className) {
+        if (pmrTypes)
+            return "std::allocate_shared< " + _className + ">(std::pmr::polymorphic_allocator< " + _className + ">())"
+        return "std::make_shared< " + _className + ">()"
     }
 
-    def private hasNoCircularDependencies(EList<FType> types) {
-        val cycleDetector = new FTypeCycleDetector(francaGeneratorExtensions)
-        return !cycleDetector.hasCycle(types)
+    def private hasSerializedSizeFunction(FType fType) {
+        fType instanceof FUnionType || fType instanceof FArrayType || fType instanceof FMapType
+            || (fType instanceof FStructType && (fType as FStructType).hasPolymorphicBase)
     }
 
-    def private List<FType> getReferencedTypes(FType fType) {
-        var references = fType.directlyReferencedTypes
-        references.addAll(references.map[it.referencedTypes].flatten.toList)
-        return references
+    def private sortTypes(EList<FType> typeList, FTypeCollection containingTypeCollection) {
+        val cycleDetector = new FTypeCycleDetector(francaGeneratorExtensions)
+        checkArgument(!cycleDetector.hasCycle(typeList), 'FTypeCollection or FInterface has circular dependencies: ' + containingTypeCollection)
+        return cycleDetector.sortTypes(typeList)
     }
 
     def dispatch generateFTypeDeclaration(FTypeDef fTypeDef, PropertyAccessor deploymentAccessor) '''
@@ -158,18 +319,195 @@ class FTypeGenerator {
     def dispatch generateFTypeDeclaration(FArrayType fArrayType, PropertyAccessor deploymentAccessor) '''
         «generateComments(fArrayType, false)»
         «IF fArrayType.elementType.derived !== null && fArrayType.elementType.derived instanceof FStructType && (fArrayType.elementType.derived as FStructType).polymorphic»
-            typedef std::vector<std::shared_ptr< «fArrayType.elementType.getElementType(fArrayType, true)»>> «fArrayType.elementName»;
+            typedef «vectorTypeName»<std::shared_ptr< «fArrayType.elementType.getElementType(fArrayType, true)»>> «fArrayType.elementName»;
         «ELSE»
-            typedef std::vector< «fArrayType.elementType.getElementType(fArrayType, true)»> «fArrayType.elementName»;
+            typedef «vectorTypeName»< «fArrayType.elementType.getElementType(fArrayType, true)»> «fArrayType.elementName»;
+        «ENDIF»
+        «IF fArrayType.structureOfArrays»
+
+            «fArrayType.generateStructureOfArraysDeclaration»
         «ENDIF»
     '''
 
+    def private generateStructureOfArraysDeclaration(FArrayType fArrayType) {
+        val fStructType = fArrayType.elementType.derived as FStructType
+        val structName = fArrayType.elementType.getElementType(fArrayType, true)
+        val soaName = fArrayType.elementName + "SoA"
+        val elements = fStructType.allElements
+        '''
+        /**
+         * Structure of arrays representation of «fArrayType.elementName»: one vector per member of «fStructType.elementName».
+         * It is a local representation only: arguments, attributes and the serialization use «fArrayType.elementName»,
+         * convert with the constructor and toArray().
+         */
+        struct «soaName» : CommonAPI::Struct< «elements.map[vectorTypeName + "< " + getTypeName(fArrayType, false) + ">"].join(", ")»> {
+            class ConstReference {
+            public:
+                ConstReference(const «soaName» *_soa, std::size_t _index) : soa_(_soa), index_(_index) {}
+                «var i = -1»
+                «FOR element : elements»
+                    «val String typeName = element.getTypeName(fArrayType, false)»
+                    inline «IF typeName.isComplex»const «typeName» &«ELSE»«typeName» «ENDIF»get«element.elementName.toFirstUpper»() const { return std::get< «i = i+1»>(soa_->values_)[index_]; }
+                «ENDFOR»
+                operator «structName»() const { return «structName»(«elements.map["get" + elementName.toFirstUpper + "()"].join(", ")»); }
+            private:
+                const «soaName» *soa_;
+                std::size_t index_;
+            };
+
+            class Reference {
+            public:
+                Reference(«soaName» *_soa, std::size_t _index) : soa_(_soa), index_(_index) {}
+                Reference(const Reference &_other) = default;
+                «var j = -1»
+                «FOR element : elements»
+                    «val String typeName = element.getTypeName(fArrayType, false)»
+                    inline «IF typeName.isComplex»const «typeName» &«ELSE»«typeName» «ENDIF»get«element.elementName.toFirstUpper»() const { return std::get< «j = j+1»>(soa_->values_)[index_]; }
+                    inline void set«element.elementName.toFirstUpper»(const «typeName» «IF typeName.isComplex»&«ENDIF»_value) { std::get< «j»>(soa_->values_)[index_] = _value; }
+                «ENDFOR»
+                operator «structName»() const { return «structName»(«elements.map["get" + elementName.toFirstUpper + "()"].join(", ")»); }
+                Reference &operator=(const «structName» &_element) {
+                    «FOR element : elements»
+                        set«element.elementName.toFirstUpper»(_element.get«element.elementName.toFirstUpper»());
+                    «ENDFOR»
+                    return *this;
+                }
+                Reference &operator=(const Reference &_other) {
+                    return (*this) = static_cast< «structName»>(_other);
+                }
+                /// Swaps the members of the referenced elements, the proxies are passed by value (std::sort, std::reverse, ...)
+                friend void swap(Reference _first, Reference _second) {
+                    using std::swap;
+                    «var m = -1»
+                    «FOR element : elements»
+                        swap(std::get< «m = m+1»>(_first.soa_->values_)[_first.index_], std::get< «m»>(_second.soa_->values_)[_second.index_]);
+                    «ENDFOR»
+                }
+            private:
+                «soaName» *soa_;
+                std::size_t index_;
+            };
+
+            /// Random access iterator over the elements. Like std::vector<bool>, it returns proxies
+            /// (ConstReference or Reference) instead of references to «structName». Swapping two
+            /// elements swaps their members, so the mutating algorithms (e.g. std::sort) can be used.
+            template<class _Reference, class _SoA>
+            class Iterator {
+            public:
+                typedef std::random_access_iterator_tag iterator_category;
+                typedef «structName» value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef _Reference reference;
+                class pointer {
+                public:
+                    explicit pointer(const _Reference &_reference) : reference_(_reference) {}
+                    _Reference *operator->() { return &reference_; }
+                private:
+                    _Reference reference_;
+                };
+
+                Iterator() : soa_(nullptr), index_(0) {}
+                Iterator(_SoA *_soa, std::size_t _index) : soa_(_soa), index_(_index) {}
+                reference operator*() const { return _Reference(soa_, index_); }
+                pointer operator->() const { return pointer(**this); }
+                reference operator[](difference_type _offset) const { return *((*this) + _offset); }
+                Iterator &operator++() { ++index_; return *this; }
+                Iterator operator++(int) { Iterator its_iterator(*this); ++index_; return its_iterator; }
+                Iterator &operator--() { --index_; return *this; }
+                Iterator operator--(int) { Iterator its_iterator(*this); --index_; return its_iterator; }
+                Iterator &operator+=(difference_type _offset) {
+                    index_ = static_cast<std::size_t>(static_cast<difference_type>(index_) + _offset);
+                    return *this;
+                }
+                Iterator &operator-=(difference_type _offset) { return (*this) += -_offset; }
+                Iterator operator+(difference_type _offset) const { Iterator its_iterator(*this); return its_iterator += _offset; }
+                Iterator operator-(difference_type _offset) const { Iterator its_iterator(*this); return its_iterator -= _offset; }
+                friend Iterator operator+(difference_type _offset, const Iterator &_iterator) { return _iterator + _offset; }
+                difference_type operator-(const Iterator &_other) const {
+                    return static_cast<difference_type>(index_) - static_cast<difference_type>(_other.index_);
+                }
+                bool operator==(const Iterator &_other) const { return (soa_ == _other.soa_ && index_ == _other.index_); }
+                bool operator!=(const Iterator &_other) const { return !((*this) == _other); }
+                bool operator<(const Iterator &_other) const { return (index_ < _other.index_); }
+                bool operator>(const Iterator &_other) const { return (_other < (*this)); }
+                bool operator<=(const Iterator &_other) const { return !(_other < (*this)); }
+                bool operator>=(const Iterator &_other) const { return !((*this) < _other); }
+                friend void iter_swap(Iterator _first, Iterator _second) { swap(*_first, *_second); }
+            private:
+                _SoA *soa_;
+                std::size_t index_;
+            };
+            typedef Iterator<Reference, «soaName»> iterator;
+            typedef Iterator<ConstReference, const «soaName»> const_iterator;
+
+            «soaName»() {}
+            explicit «soaName»(const «fArrayType.elementName» &_array) {
+                reserve(_array.size());
+                for (const auto &its_element : _array)
+                    push_back(its_element);
+            }
+
+            «fArrayType.elementName» toArray() const {
+                «fArrayType.elementName» its_array;
+                its_array.reserve(size());
+                for (std::size_t its_index = 0; its_index < size(); its_index++)
+                    its_array.push_back((*this)[its_index]);
+                return its_array;
+            }
+
+            inline std::size_t size() const { return std::get< 0>(values_).size(); }
+            inline bool empty() const { return std::get< 0>(values_).empty(); }
+            void reserve(std::size_t _size) {
+                «FOR index : 0 ..< elements.size»
+                    std::get< «index»>(values_).reserve(_size);
+                «ENDFOR»
+            }
+            void clear() {
+                «FOR index : 0 ..< elements.size»
+                    std::get< «index»>(values_).clear();
+                «ENDFOR»
+            }
+            void push_back(const «structName» &_element) {
+                «var k = -1»
+                «FOR element : elements»
+                    std::get< «k = k+1»>(values_).push_back(_element.get«element.elementName.toFirstUpper»());
+                «ENDFOR»
+            }
+
+            inline ConstReference operator[](std::size_t _index) const { return ConstReference(this, _index); }
+            inline Reference operator[](std::size_t _index) { return Reference(this, _index); }
+            inline const_iterator begin() const { return const_iterator(this, 0); }
+            inline const_iterator end() const { return const_iterator(this, size()); }
+            inline iterator begin() { return iterator(this, 0); }
+            inline iterator end() { return iterator(this, size()); }
+
+            «var l = -1»
+            «FOR element : elements»
+                «val String typeName = element.getTypeName(fArrayType, false)»
+                inline const «vectorTypeName»< «typeName»> &get«element.elementName.toFirstUpper»Values() const { return std::get< «l = l+1»>(values_); }
+                inline «vectorTypeName»< «typeName»> &get«element.elementName.toFirstUpper»Values() { return std::get< «l»>(values_); }
+            «ENDFOR»
+
+            inline bool operator==(const «soaName» &_other) const {
+                return values_ == _other.values_;
+            }
+            inline bool operator!=(const «soaName» &_other) const {
+                return !((*this) == _other);
+            }
+        };
+        '''
+    }
+
     def dispatch generateFTypeDeclaration(FMapType fMap, PropertyAccessor deploymentAccessor) '''
         «generateComments(fMap, false)»
-        typedef std::unordered_map< «fMap.generateKeyType», «fMap.generateValueType»«fMap.generateHasher»> «fMap.elementName»;
+        typedef «IF pmrTypes»std::pmr::unordered_map«ELSE»std::unordered_map«ENDIF»< «fMap.generateKeyType», «fMap.generateValueType»«fMap.generateHasher»> «fMap.elementName»;
     '''
 
     def dispatch generateFTypeDeclaration(FStructType fStructType, PropertyAccessor deploymentAccessor) '''
+        «IF trivialStructs && fStructType.triviallyCopyable»
+            «fStructType.generateTrivialStructDeclaration»
+
+        «ENDIF»
         «generateComments(fStructType, false)»
         «IF fStructType.polymorphic»
         «fStructType.createSerials()»
@@ -182,7 +520,7 @@ class FTypeGenerator {
             struct «fStructType.elementName» : «fStructType.base.getElementName(fStructType, false)» {
             «ENDIF»
         «ELSE»
-            struct «fStructType.elementName» : CommonAPI::Struct< «fStructType.allElements.map[getTypeName(fStructType, false)].join(", ")»> {
+            struct «fStructType.elementName» : CommonAPI::Struct< «fStructType.tupleTypeNames.join(", ")»> {
         «ENDIF»
             «IF fStructType.hasPolymorphicBase()»
                 «IF fStructType.polymorphic || (fStructType.hasPolymorphicBase() && fStructType.hasDerivedTypes())»
@@ -202,10 +540,16 @@ class FTypeGenerator {
                     «var nindex = n»
                     «IF (fStructType.hasPolymorphicBase)»
                         «{ nindex = n - (fStructType.allElements.size - fStructType.elements.size); "" }»
+                    «ELSEIF fStructType.packedBooleans»
+                        «{ nindex = fStructType.getTupleIndex(element); "" }»
                     «ENDIF»
-                    «IF nindex >= 0 »
+                    «IF fStructType.isPackedBoolean(element)»
+                        «IF fStructType.isFirstPackedBoolean(element)»
+                                std::get< «nindex»>(values_) = 0;
+                        «ENDIF»
+                    «ELSEIF nindex >= 0 »
                         «IF (element.type.derived instanceof FStructType && (element.type.derived as FStructType).hasPolymorphicBase) && !element.array»
-                                std::get< «nindex»>(values_) = std::make_shared< «element.type.getElementType(fStructType, false)»>();
+                                std::get< «nindex»>(values_) = «element.type.getElementType(fStructType, false).generateMakeShared»;
                         «ELSEIF element.type.derived !== null && !element.array»
                                 std::get< «nindex»>(values_) = «element.getTypeName(fStructType, false)»();
                         «ELSEIF element.type.interval !== null && !element.array»
@@ -231,6 +575,17 @@ class FTypeGenerator {
                         «FOR element : fStructType.elements»
                             std::get< «i = i+1»>(values_) = _«element.elementName»;
                         «ENDFOR»
+                    «ELSEIF fStructType.packedBooleans»
+                        «FOR element : fStructType.allElements»
+                            «IF fStructType.isFirstPackedBoolean(element)»
+                                std::get< «fStructType.getTupleIndex(element)»>(values_) = 0;
+                            «ENDIF»
+                            «IF fStructType.isPackedBoolean(element)»
+                                set«element.elementName.toFirstUpper»(_«element.elementName»);
+                            «ELSE»
+                                std::get< «fStructType.getTupleIndex(element)»>(values_) = _«element.elementName»;
+                            «ENDIF»
+                        «ENDFOR»
                     «ELSE»
                         «var i = -1»
                         «FOR element : fStructType.allElements»
@@ -239,6 +594,20 @@ class FTypeGenerator {
                     «ENDIF»
                 }
             «ENDIF»
+            «IF pmrTypes && !fStructType.hasPolymorphicBase()»
+                «val String types = fStructType.tupleTypeNames.join(", ")»
+
+                /// The strings and containers of the struct use the memory resource of the allocator.
+                typedef std::pmr::polymorphic_allocator<char> allocator_type;
+                «fStructType.elementName»(std::allocator_arg_t, const allocator_type &_allocator)
+                    : CommonAPI::Struct< «types»>{ std::tuple< «types»>(std::allocator_arg, _allocator) } {
+                    values_ = «fStructType.elementName»().values_;
+                }
+                «fStructType.elementName»(std::allocator_arg_t, const allocator_type &_allocator, const «fStructType.elementName» &_other)
+                    : CommonAPI::Struct< «types»>{ std::tuple< «types»>(std::allocator_arg, _allocator) } {
+                    values_ = _other.values_;
+                }
+            «ENDIF»
             «IF fStructType.hasPolymorphicBase()»
             template<class _Input>
             void readValue(CommonAPI::InputStream<_Input> &_input, const CommonAPI::EmptyDeployment *_depl) {
@@ -372,13 +741,60 @@ class FTypeGenerator {
             std::tuple< «fStructType.elements.map[getTypeName(fStructType, false)].join(", ")»> values_;
             «ENDIF»
         «ELSE»
-            «var k = -1»
             «FOR element : fStructType.allElements»
                 «generateComments(element, false)»
                 «val String typeName = element.getTypeName(fStructType, false)»
-                inline const «typeName» &get«element.elementName.toFirstUpper»() const { return std::get< «k = k+1»>(values_); }
-                inline void set«element.elementName.toFirstUpper»(const «typeName» «IF typeName.isComplex»&«ENDIF»_value) { std::get< «k»>(values_) = _value; }
+                «val int k = fStructType.getTupleIndex(element)»
+                «IF fStructType.isPackedBoolean(element)»
+                    «val String mask = fStructType.getPackedBooleanMask(element)»
+                    inline bool get«element.elementName.toFirstUpper»() const { return ((std::get< «k»>(values_) & «mask») != 0); }
+                    inline void set«element.elementName.toFirstUpper»(const bool _value) { if (_value) std::get< «k»>(values_) |= «mask»; else std::get< «k»>(values_) &= static_cast< «fStructType.packedBooleansType.primitiveTypeName»>(~«mask»); }
+                «ELSE»
+                    inline const «typeName» &get«element.elementName.toFirstUpper»() const { return std::get< «k»>(values_); }
+                    inline void set«element.elementName.toFirstUpper»(const «typeName» «IF typeName.isComplex»&«ENDIF»_value) { std::get< «k»>(values_) = _value; }
+                «ENDIF»
             «ENDFOR»
+            «IF trivialStructs && fStructType.triviallyCopyable»
+
+                explicit «fStructType.elementName»(const «fStructType.elementName»Data &_data) {
+                    «var i = -1»
+                    «FOR element : fStructType.allElements»
+                        «IF element.type.trivialEnumeration !== null»
+                            std::get< «i = i+1»>(values_) = «element.getTypeName(fStructType, false)»(static_cast< «element.getTypeName(fStructType, false)»::Literal>(_data.«element.elementName»));
+                        «ELSEIF element.type.trivialBoolean»
+                            std::get< «i = i+1»>(values_) = (_data.«element.elementName» != 0);
+                        «ELSE»
+                            std::get< «i = i+1»>(values_) = _data.«element.elementName»;
+                        «ENDIF»
+                    «ENDFOR»
+                }
+                inline «fStructType.elementName»Data getData() const {
+                    «fStructType.elementName»Data its_data;
+                    «var j = -1»
+                    «FOR element : fStructType.allElements»
+                        «IF element.type.trivialEnumeration !== null || element.type.trivialBoolean»
+                            its_data.«element.elementName» = static_cast< «element.type.trivialTypeName»>(std::get< «j = j+1»>(values_));
+                        «ELSE»
+                            its_data.«element.elementName» = std::get< «j = j+1»>(values_);
+                        «ENDIF»
+                    «ENDFOR»
+                    return its_data;
+                }
+            «ENDIF»
+            «IF serializedSize»
+
+                /// Returns the size of the serialized struct, computed by the size stream _Sizer of a binding.
+                template<class _Sizer, class _Deployment>
+                std::size_t serializedSize(const _Deployment *_depl) const {
+                    _Sizer its_sizer;
+                    its_sizer.writeValue(*this, _depl);
+                    return its_sizer.getSize();
+                }
+                «IF fStructType.packedSize >= 0»
+                    /// All members have a fixed size. Without alignment and length fields, their values take this number of bytes.
+                    static constexpr std::size_t getPackedSize() { return «fStructType.packedSize»; }
+                «ENDIF»
+            «ENDIF»
         «ENDIF»
             inline bool operator==(const «fStructType.name»& _other) const {
             «IF fStructType.allElements.size > 0»
@@ -393,6 +809,10 @@ class FTypeGenerator {
             }
 
         };
+        «IF fStructType.hasPackedBooleansStruct»
+
+            «fStructType.generatePackedBooleansStructDeclaration»
+        «ENDIF»
     '''
 
     def dispatch generateFTypeDeclaration(FEnumerationType fEnumerationType, PropertyAccessor deploymentAccessor) {
@@ -564,11 +984,11 @@ class FTypeGenerator {
         std::shared_ptr< «fStructType.getClassNamespace(parent)»> «fStructType.getClassNamespace(parent)»::create(CommonAPI::Serial _serial) {
             switch (_serial) {
             case «parent.elementName»::«fStructType.elementName.toUpperCase()»_SERIAL:
-                return std::make_shared< «fStructType.getClassNamespace(parent)»>();
+                return «fStructType.getClassNamespace(parent).generateMakeShared»;
             «FOR derived : fStructType.derivedFStructTypes»
             «derived.generateCases(parent, true)»
                 «IF derived.derivedFStructTypes.empty»
-                return std::make_shared< «derived.getClassNamespace(parent)»>();
+                return «derived.getClassNamespace(parent).generateMakeShared»;
                 «ELSE»
                 return «derived.getClassNamespace(parent)»::create(_serial);
                 «ENDIF»
@@ -619,8 +1039,9 @@ class FTypeGenerator {
             errorEnum?.addRequiredHeaders(generatedHeaders, libraryHeaders)
         ]
         if (isStub) {
+            // the stubs of managed interfaces are only passed as shared pointers
             fInterface.managedInterfaces.forEach[
-                generatedHeaders.add(stubHeaderPath)
+                generatedHeaders.add(if (leanHeaders) fwdHeaderPath else stubHeaderPath)
             ]
         }
         fInterface.broadcasts.forEach[outArgs.forEach[type.derived?.addRequiredHeaders(generatedHeaders, libraryHeaders)]]
@@ -631,6 +1052,8 @@ class FTypeGenerator {
     def addRequiredHeaders(FType fType, Collection<String> generatedHeaders, Collection<String> libraryHeaders) {
         generatedHeaders.add(fType.FTypeCollection.headerPath)
         fType.addFTypeRequiredHeaders(generatedHeaders, libraryHeaders)
+        if (serializedSize)
+            libraryHeaders.add('cstddef')
     }
 
     def private getFTypeCollection(FType fType) {
@@ -642,10 +1065,16 @@ class FTypeGenerator {
     }
     def private dispatch void addFTypeRequiredHeaders(FArrayType fArrayType, Collection<String> generatedHeaders, Collection<String> libraryHeaders) {
         libraryHeaders.add('vector')
+        if (pmrTypes)
+            libraryHeaders.add('memory_resource')
+        if (fArrayType.structureOfArrays)
+            libraryHeaders.addAll('cstddef', 'iterator', 'utility', 'CommonAPI/Struct.hpp')
         fArrayType.elementType.getRequiredHeaderPath(generatedHeaders, libraryHeaders)
     }
     def private dispatch void addFTypeRequiredHeaders(FMapType fMapType, Collection<String> generatedHeaders, Collection<String> libraryHeaders) {
         libraryHeaders.add('unordered_map')
+        if (pmrTypes)
+            libraryHeaders.add('memory_resource')
         fMapType.keyType.getRequiredHeaderPath(generatedHeaders, libraryHeaders)
         fMapType.valueType.getRequiredHeaderPath(generatedHeaders, libraryHeaders)
     }
@@ -654,6 +1083,10 @@ class FTypeGenerator {
             generatedHeaders.add(fStructType.base.FTypeCollection.headerPath)
         else
             libraryHeaders.addAll('CommonAPI/Deployment.hpp', 'CommonAPI/InputStream.hpp', 'CommonAPI/OutputStream.hpp', 'CommonAPI/Struct.hpp')
+        if (trivialStructs && fStructType.triviallyCopyable)
+            libraryHeaders.addAll('cstddef', 'cstdint', 'cstring', 'type_traits')
+        if (pmrTypes)
+            libraryHeaders.addAll('memory', 'memory_resource', 'tuple')
         if (fStructType.polymorphic || (fStructType.hasPolymorphicBase() && fStructType.hasDerivedTypes()))
             libraryHeaders.add('CommonAPI/Export.hpp')
         fStructType.elements.forEach[type.getRequiredHeaderPath(generatedHeaders, libraryHeaders)]
@@ -0,0 +1,68 @@
+/* Copyright (C) 2020 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+   This Source Code Form is subject to the terms of the Mozilla Public
+   License, v. 2.0. If a copy of the MPL was not distributed with this
+   file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+package org.genivi.commonapi.core.generator
+
+import javax.inject.Inject
+import org.eclipse.xtext.generator.IFileSystemAccess
+
+/**
+ * Generates the unity build files of a Franca package: <package>_unity.cpp includes all
+ * generated sources of the package, <package>_pch.hpp includes the common headers of the
+ * package in dependency order and can be used as precompiled header.
+ */
+class FUnityBuildGenerator {
+    @Inject extension FrancaGeneratorExtensions
+
+    def generateUnityBuild(String packageName, UnityBuildCollector collector, IFileSystemAccess fileSystemAccess) {
+        val headers = collector.getHeaders(packageName)
+        val sources = collector.getSources(packageName)
+        if (headers.empty && sources.empty) {
+            return
+        }
+        fileSystemAccess.generateFile(packageName.precompiledHeaderPath, IFileSystemAccess.DEFAULT_OUTPUT,
+            packageName.generatePrecompiledHeader(headers))
+        if (!sources.empty) {
+            fileSystemAccess.generateFile(packageName.unityBuildSourcePath, IFileSystemAccess.DEFAULT_OUTPUT,
+                packageName.generateUnityBuildSource(sources))
+        }
+    }
+
+    def private generatePrecompiledHeader(String packageName, Iterable<String> headers) '''
+        «generateCommonApiLicenseHeader()»
+        #ifndef «packageName.unityBuildDefineName»_PCH_HPP_
+        #define «packageName.unityBuildDefineName»_PCH_HPP_
+
+        «FOR header : headers»
+            #include <«header»>
+        «ENDFOR»
+
+        #endif // «packageName.unityBuildDefineName»_PCH_HPP_
+    '''
+
+    def private generateUnityBuildSource(String packageName, Iterable<String> sources) '''
+        «generateCommonApiLicenseHeader()»
+        #include <«packageName.precompiledHeaderPath»>
+
+        «FOR source : sources»
+            #include <«source»>
+        «ENDFOR»
+    '''
+
+    def private getUnityBuildDefineName(String packageName) {
+        packageName.replace('.', '_').toUpperCase
+    }
+
+    def private getUnityBuildPrefix(String packageName) {
+        packageName.replace('.', '/') + '/' + packageName.replace('.', '_')
+    }
+
+    def getUnityBuildSourcePath(String packageName) {
+        packageName.unityBuildPrefix + "_unity.cpp"
+    }
+
+    def getPrecompiledHeaderPath(String packageName) {
+        packageName.unityBuildPrefix + "_pch.hpp"
+    }
+}
@@ -6,15 +6,25 @@ package org.genivi.commonapi.core.generator
 
 import java.io.File
 import java.util.ArrayList
+import java.util.HashMap
 import java.util.HashSet
 import java.util.List
 import java.util.Map
 import java.util.Set
+import java.util.TreeMap
+import java.util.TreeSet
+import java.util.concurrent.ExecutionException
+import java.util.concurrent.ExecutorService
+import java.util.concurrent.Executors
+import java.util.concurrent.Future
 import javax.inject.Inject
 import org.eclipse.core.resources.IResource
 import org.eclipse.emf.ecore.resource.Resource
+import org.eclipse.emf.ecore.util.EcoreUtil
+import org.eclipse.xtext.generator.AbstractFileSystemAccess
 import org.eclipse.xtext.generator.IFileSystemAccess
 import org.eclipse.xtext.generator.IGenerator
+import org.eclipse.xtext.generator.OutputConfiguration
 import org.franca.core.dsl.FrancaPersistenceManager
 import org.franca.core.franca.FInterface
 import org.franca.core.franca.FModel
@@ -35,6 +45,7 @@ class FrancaGenerator implements IGenerator {
 	@Inject extension FInterfaceGenerator
 	@Inject extension FInterfaceProxyGenerator
 	@Inject extension FInterfaceStubGenerator
+	@Inject extension FUnityBuildGenerator
 	@Inject extension FrancaGeneratorExtensions
 
     //@Inject FrancaPersistenceManager francaPersistenceManager
@@ -42,6 +53,36 @@ class FrancaGenerator implements IGenerator {
 
     val String CORE_SPECIFICATION_TYPE = "core.deployment"
 
+    /**
+     * Starts an invocation that consists of several calls of doGenerate (e.g. for all files given
+     * on the command line). Within an invocation, each model is generated only once for the same
+     * deployments, even if it is imported by several input files.
+     */
+    def void startInvocation() {
+        invocationModels_ = new HashMap<String, RecordingFileSystemAccess>()
+        invocationUnityBuild_ = new UnityBuildCollector()
+    }
+
+    /**
+     * Finishes the invocation started by startInvocation and releases the loaded models.
+     */
+    def void finishInvocation() {
+        invocationModels_ = null
+        invocationUnityBuild_ = null
+        generatedFiles_ = null
+        loadedModels_ = new TreeSet<String>()
+        clearAccessors
+        fDeployManager.resourceSet = null
+    }
+
+    /**
+     * @return the URIs of the files loaded by the last call of doGenerate, i.e. the input file
+     * and its transitive imports
+     */
+    def Set<String> getLoadedModels() {
+        return loadedModels_
+    }
+
     override doGenerate(Resource input, IFileSystemAccess fileSystemAccess) {
         if (!input.URI.fileExtension.equals(FrancaPersistenceManager.FRANCA_FILE_EXTENSION) &&
             !input.URI.fileExtension.equals(FDeployManager.fileExtension)) {
@@ -53,14 +94,44 @@ class FrancaGenerator implements IGenerator {
         var List<FDExtensionRoot> deployedProviders = new ArrayList<FDExtensionRoot>()
         var IResource res = null
 
+        // load the imports into the resource set of the input, it is already parsed there
+        if (input.resourceSet !== null) {
+            fDeployManager.resourceSet = input.resourceSet
+        }
+        fDeployManager.clearLoadedModels
+        val loadingMeasurement = GeneratorProfiler.start(GeneratorProfiler.PHASE, GeneratorProfiler.LOADING)
         var rootModel = fDeployManager.loadModel(input.URI, input.URI);
+        GeneratorProfiler.stop(loadingMeasurement)
+        loadedModels_ = new TreeSet<String>(fDeployManager.loadedModels)
 
-        generatedFiles_ = new HashSet<String>()
+        if (invocationModels_ !== null) {
+            generatedFiles_ = invocationModels_
+        } else {
+            generatedFiles_ = new HashMap<String, RecordingFileSystemAccess>()
+        }
+
+        // the unity build files of a package list the files of all input files of the invocation
+        if (unityBuild) {
+            unityBuild_ = if (invocationUnityBuild_ !== null) invocationUnityBuild_ else new UnityBuildCollector()
+        } else {
+            unityBuild_ = null
+        }
 
         withDependencies_ = FPreferences::instance.getPreference(
             PreferenceConstants::P_GENERATE_DEPENDENCIES, "true"
         ).equals("true")
 
+        var int itsJobs = 1
+        try {
+            itsJobs = Integer.parseInt(FPreferences::instance.getPreference(
+                PreferenceConstants::P_JOBS, PreferenceConstants::DEFAULT_JOBS))
+        } catch (NumberFormatException e) {
+            // invalid values are treated as sequential generation
+        }
+        if (itsJobs > 1) {
+            executor_ = Executors.newFixedThreadPool(itsJobs)
+        }
+
         // models holds the map of all models from imported .fidl files
         var models = fDeployManager.fidlModels
         // deployments holds the map of all models from imported .fdepl files
@@ -86,14 +157,37 @@ class FrancaGenerator implements IGenerator {
             deployedProviders.addAll(itsProviders)
         }
 
-        if (rootModel instanceof FDModel) {
-            doGenerateDeployment(rootModel, deployments, models,
-                deployedInterfaces, deployedTypeCollections, deployedProviders,
-                fileSystemAccess, res, true)
-        } else if (rootModel instanceof FModel) {
-            doGenerateModel(rootModel, models,
-                deployedInterfaces, deployedTypeCollections, deployedProviders,
-                fileSystemAccess, res)
+        // derived structs are looked up often, index them once for all models
+        val indexedResourceSet = rootModel?.eResource?.resourceSet
+        if (indexedResourceSet !== null) {
+            buildDerivedFStructTypesIndex(indexedResourceSet)
+        }
+
+        val generationMeasurement = GeneratorProfiler.start(GeneratorProfiler.PHASE, GeneratorProfiler.GENERATION)
+        try {
+            if (rootModel instanceof FDModel) {
+                doGenerateDeployment(rootModel, deployments, models,
+                    deployedInterfaces, deployedTypeCollections, deployedProviders,
+                    fileSystemAccess, res, true)
+            } else if (rootModel instanceof FModel) {
+                doGenerateModel(rootModel, models,
+                    deployedInterfaces, deployedTypeCollections, deployedProviders,
+                    fileSystemAccess, res)
+            }
+            if (unityBuild_ !== null) {
+                for (itsPackage : unityBuild_.takeTouchedPackages) {
+                    generateUnityBuild(itsPackage, unityBuild_, fileSystemAccess)
+                }
+            }
+        } finally {
+            GeneratorProfiler.stop(generationMeasurement)
+            if (indexedResourceSet !== null) {
+                clearDerivedFStructTypesIndex(indexedResourceSet)
+            }
+            if (executor_ !== null) {
+                executor_.shutdownNow
+                executor_ = null
+            }
         }
 
         fDeployManager.clearFidlModels
@@ -163,13 +257,7 @@ class FrancaGenerator implements IGenerator {
         val String modelName
             = _models.entrySet.filter[it.value == _model].head.key
 
-        if (generatedFiles_.contains(modelName)) {
-            return
-        }
-
-        generatedFiles_.add(modelName);
-
-        doGenerateComponents(_model,
+        generateOnce(_model, modelName,
             _interfaces, _typeCollections, _providers,
             _access, _res)
 
@@ -177,7 +265,7 @@ class FrancaGenerator implements IGenerator {
             for (itsEntry : _models.entrySet) {
                 var FModel itsModel = itsEntry.value
                 if (itsModel !== null && itsModel != _model) {
-                    doGenerateComponents(itsModel,
+                    generateOnce(itsModel, itsEntry.key,
                         _interfaces, _typeCollections, _providers,
                         _access, _res)
                 }
@@ -185,6 +273,62 @@ class FrancaGenerator implements IGenerator {
         }
     }
 
+    /**
+     * Generates the components of the model unless it was already generated with the same
+     * deployments. In that case, the files generated before are added to the file list of the
+     * file system access again, as they are outputs of the current input file as well.
+     */
+    def private void generateOnce(FModel _model,
+                                  String _modelName,
+                                  List<FDInterface> _interfaces,
+                                  List<FDTypes> _typeCollections,
+                                  List<FDExtensionRoot> _providers,
+                                  IFileSystemAccess _access,
+                                  IResource _res) {
+        val String itsKey = getGenerationKey(_model, _modelName, _interfaces, _typeCollections, _providers, _access)
+        val RecordingFileSystemAccess itsGenerated = generatedFiles_.get(itsKey)
+        if (itsGenerated === null) {
+            val RecordingFileSystemAccess itsAccess = new RecordingFileSystemAccess(_access)
+            generatedFiles_.put(itsKey, itsAccess)
+            doGenerateComponents(_model,
+                _interfaces, _typeCollections, _providers,
+                itsAccess, _res)
+        } else if (_access instanceof GeneratorFileSystemAccess) {
+            itsGenerated.replay(_access)
+        }
+    }
+
+    /**
+     * The key consists of the model name and the names of the deployments that refer to it,
+     * as these determine the generated code, and of the output directories. With --dest-subdirs,
+     * each input file has its own output directories, so a model that several input files import
+     * is generated into each of them.
+     */
+    def private String getGenerationKey(FModel _model,
+                                        String _modelName,
+                                        List<FDInterface> _interfaces,
+                                        List<FDTypes> _typeCollections,
+                                        List<FDExtensionRoot> _providers,
+                                        IFileSystemAccess _access) {
+        val Set<String> itsDeployments = new TreeSet<String>()
+        _interfaces.filter[target?.eContainer == _model].forEach[
+            itsDeployments.add(String.valueOf(eResource?.URI))
+        ]
+        _typeCollections.filter[target?.eContainer == _model].forEach[
+            itsDeployments.add(String.valueOf(eResource?.URI))
+        ]
+        _providers.filter[ProviderUtils.getInstances(it).exists[target?.eContainer == _model]].forEach[
+            itsDeployments.add(String.valueOf(eResource?.URI))
+        ]
+        var String itsOutputs = ""
+        if (_access instanceof AbstractFileSystemAccess) {
+            itsOutputs = new TreeMap<String, OutputConfiguration>(_access.outputConfigurations).entrySet.map[
+                key + "=" + value.outputDirectory
+            ].join("|")
+        }
+        return _modelName + "|" + itsDeployments.join("|") + "|" + itsOutputs
+    }
+
     def private void doInsertAccessors(FModel _model,
                                        List<FDInterface> _deployedInterfaces,
                                        List<FDTypes> _deployedTypeCollections) {
@@ -231,6 +375,20 @@ class FrancaGenerator implements IGenerator {
         var typeCollectionsToGenerate = _model.typeCollections.toSet
         var interfacesToGenerate = _model.interfaces.toSet
 
+        // The contents are rendered in parallel (if configured), but the files are written one at a time
+        val List<Runnable> itsTasks = new ArrayList<Runnable>()
+        var IFileSystemAccess itsAccess = _fileSystemAccess
+        if (unityBuild_ !== null) {
+            itsAccess = unityBuild_.wrap(_model.name, itsAccess)
+        }
+        val IFileSystemAccess itsPackageAccess = itsAccess
+        if (executor_ !== null) {
+            itsAccess = new SynchronizedFileSystemAccess(itsPackageAccess)
+            // resolve all cross references before the model is read by several threads
+            EcoreUtil.resolveAll(_model)
+        }
+        val IFileSystemAccess itsFileSystemAccess = itsAccess
+
         typeCollectionsToGenerate.forEach[
             val currentTypeCollection = it
             if (!(currentTypeCollection instanceof FInterface)) {
@@ -239,7 +397,13 @@ class FrancaGenerator implements IGenerator {
                     if (currentPropertyAccessor === null) {
                         currentPropertyAccessor = new PropertyAccessor()
                     }
-                    generate(it, _fileSystemAccess, currentPropertyAccessor, _res)
+                    val itsPropertyAccessor = currentPropertyAccessor
+                    itsTasks.add([|
+                        val itsMeasurement = GeneratorProfiler.start(GeneratorProfiler.ARTIFACT, GeneratorProfiler.COMMON,
+                            currentTypeCollection.fullyQualifiedName)
+                        generate(currentTypeCollection, itsFileSystemAccess, itsPropertyAccessor, _res)
+                        GeneratorProfiler.stop(itsMeasurement)
+                    ])
                 }
             }
         ]
@@ -247,23 +411,34 @@ class FrancaGenerator implements IGenerator {
         // for all interfaces
         interfacesToGenerate.forEach [
             val currentInterface = it
-            var PropertyAccessor deploymentAccessor
+            var PropertyAccessor currentDeploymentAccessor
             if (_deployedInterfaces.exists[it.target == currentInterface]) {
-                deploymentAccessor = new PropertyAccessor(
+                currentDeploymentAccessor = new PropertyAccessor(
                     new FDeployedInterface(_deployedInterfaces.filter[it.target == currentInterface].last))
             } else {
-                deploymentAccessor = new PropertyAccessor()
-            }
-            if (FPreferences::instance.getPreference(PreferenceConstants::P_GENERATE_PROXY, "true").equals("true")) {
-                it.generateProxy(_fileSystemAccess, deploymentAccessor, _res)
-            }
-            if (FPreferences::instance.getPreference(PreferenceConstants::P_GENERATE_STUB, "true").equals("true")) {
-                it.generateStub(_fileSystemAccess, deploymentAccessor, _res)
-            }
-            if (FPreferences::instance.getPreference(PreferenceConstants::P_GENERATE_COMMON, "true").equals("true")) {
-                generateInterface(it, _fileSystemAccess, deploymentAccessor, _res)
+                currentDeploymentAccessor = new PropertyAccessor()
             }
+            val deploymentAccessor = currentDeploymentAccessor
+            itsTasks.add([|
+                if (FPreferences::instance.getPreference(PreferenceConstants::P_GENERATE_PROXY, "true").equals("true")) {
+                    val itsMeasurement = GeneratorProfiler.start(GeneratorProfiler.ARTIFACT, GeneratorProfiler.PROXY,
+                        currentInterface.fullyQualifiedName)
+                    currentInterface.generateProxy(itsFileSystemAccess, deploymentAccessor, _res)
+                    GeneratorProfiler.stop(itsMeasurement)
+                }
+                if (FPreferences::instance.getPreference(PreferenceConstants::P_GENERATE_STUB, "true").equals("true")) {
+                    currentInterface.generateStub(itsFileSystemAccess, deploymentAccessor, _res)
+                }
+                if (FPreferences::instance.getPreference(PreferenceConstants::P_GENERATE_COMMON, "true").equals("true")) {
+                    val itsMeasurement = GeneratorProfiler.start(GeneratorProfiler.ARTIFACT, GeneratorProfiler.COMMON,
+                        currentInterface.fullyQualifiedName)
+                    generateInterface(currentInterface, itsFileSystemAccess, deploymentAccessor, _res)
+                    GeneratorProfiler.stop(itsMeasurement)
+                }
+            ])
         ]
+        runTasks(itsTasks)
+
         // generate interface instance header
         interfacesToGenerate.forEach [
             val currentInterface = it
@@ -278,11 +453,41 @@ class FrancaGenerator implements IGenerator {
                 ]
             ]
             if (!deployedInstances.isEmpty) {
-                currentInterface.generateInstanceIds(_fileSystemAccess, deployedInstances)
+                currentInterface.generateInstanceIds(itsPackageAccess, deployedInstances)
             }
         ]
     }
 
+    /**
+     * Runs the given generation tasks on the worker threads (if configured) and waits for
+     * their completion. The first failure of a task is rethrown.
+     */
+    def private void runTasks(List<Runnable> _tasks) {
+        if (executor_ === null || _tasks.size <= 1) {
+            for (itsTask : _tasks) {
+                itsTask.run
+            }
+            return
+        }
+
+        val List<Future<?>> itsResults = new ArrayList<Future<?>>()
+        for (itsTask : _tasks) {
+            itsResults.add(executor_.submit(itsTask))
+        }
+        for (itsResult : itsResults) {
+            try {
+                itsResult.get
+            } catch (ExecutionException e) {
+                throw e.cause
+            }
+        }
+    }
+
     boolean withDependencies_ = false
-	Set<String> generatedFiles_;
+	Map<String, RecordingFileSystemAccess> generatedFiles_;
+    Map<String, RecordingFileSystemAccess> invocationModels_ = null
+    UnityBuildCollector invocationUnityBuild_ = null
+    UnityBuildCollector unityBuild_ = null
+    Set<String> loadedModels_ = new TreeSet<String>()
+    ExecutorService executor_ = null
 }
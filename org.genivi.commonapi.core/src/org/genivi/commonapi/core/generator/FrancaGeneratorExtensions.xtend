@@ -13,20 +13,25 @@ import java.io.IOException
 import java.math.BigInteger
 import java.util.ArrayList
 import java.util.Collection
+import java.util.Collections
 import java.util.HashMap
 import java.util.HashSet
 import java.util.LinkedHashMap
 import java.util.LinkedList
 import java.util.List
 import java.util.Map
+import java.util.Set
 import java.util.SortedMap
 import java.util.TreeMap
+import java.util.concurrent.ConcurrentHashMap
 import java.util.jar.Manifest
 import org.eclipse.core.resources.ResourcesPlugin
 import org.eclipse.core.runtime.Path
 import org.eclipse.emf.common.util.EList
+import org.eclipse.emf.common.util.URI
 import org.eclipse.emf.ecore.EObject
 import org.eclipse.emf.ecore.resource.Resource
+import org.eclipse.emf.ecore.resource.ResourceSet
 import org.eclipse.emf.ecore.util.EcoreUtil
 import org.eclipse.xtext.nodemodel.util.NodeModelUtils
 import org.franca.core.franca.FArgument
@@ -74,7 +79,9 @@ import org.franca.deploymodel.dsl.fDeploy.FDTypeDefinition
 import org.franca.deploymodel.dsl.fDeploy.FDTypes
 import org.franca.deploymodel.dsl.fDeploy.FDUnion
 import org.genivi.commonapi.core.deployment.PropertyAccessor
+import org.genivi.commonapi.core.deployment.PropertyAccessor.ArrayLayout
 import org.genivi.commonapi.core.deployment.PropertyAccessor.EnumBackingType
+import org.genivi.commonapi.core.deployment.PropertyAccessor.StubDispatch
 import org.genivi.commonapi.core.preferences.FPreferences
 import org.genivi.commonapi.core.preferences.PreferenceConstants
 import org.osgi.framework.FrameworkUtil
@@ -85,7 +92,8 @@ import static extension java.lang.Integer.*
 
 class FrancaGeneratorExtensions {
 
-    static Map<FTypeCollection, PropertyAccessor> accessors__ = new HashMap<FTypeCollection, PropertyAccessor>()
+    static Map<FTypeCollection, PropertyAccessor> accessors__ = new ConcurrentHashMap<FTypeCollection, PropertyAccessor>()
+    static Map<ResourceSet, Map<FStructType, List<FStructType>>> derivedFStructTypes__ = new ConcurrentHashMap<ResourceSet, Map<FStructType, List<FStructType>>>()
 
     def startInternalCompilation() '''
         #if !defined (COMMONAPI_INTERNAL_COMPILATION)
@@ -105,6 +113,10 @@ class FrancaGeneratorExtensions {
         accessors__.put(_tc, _pa)
     }
 
+    def clearAccessors() {
+        accessors__.clear
+    }
+
     def PropertyAccessor getAccessor(FTypeCollection _tc) {
      // get the accessor that matches this interface (tc)
         var access = accessors__.get(_tc)
@@ -367,6 +379,24 @@ class FrancaGeneratorExtensions {
         fTypeCollection.versionPathPrefix + fTypeCollection.model.directoryPath + '/' + fTypeCollection.headerFile
     }
 
+    def getFwdHeaderFile(FTypeCollection fTypeCollection) {
+        fTypeCollection.elementName + "Fwd.hpp"
+    }
+
+    def getFwdHeaderPath(FTypeCollection fTypeCollection) {
+        fTypeCollection.versionPathPrefix + fTypeCollection.model.directoryPath + '/' + fTypeCollection.fwdHeaderFile
+    }
+
+    /**
+     * In lean header mode, forward declaration headers are generated. They are only included
+     * for the stubs of managed interfaces: the Franca types are nested in their interface or
+     * type collection class and can not be declared without it, so the proxy and stub headers
+     * still include the complete headers of the types they use.
+     */
+    def boolean isLeanHeaders() {
+        FPreferences::instance.getPreference(PreferenceConstants::P_LEAN_HEADERS, "false").equals("true")
+    }
+
     def getInstanceHeaderPath(FTypeCollection fTypeCollection) {
         fTypeCollection.versionPathPrefix + fTypeCollection.model.directoryPath + '/' + fTypeCollection.instanceHeaderFile
     }
@@ -399,6 +429,63 @@ class FrancaGeneratorExtensions {
         fInterface.versionPathPrefix + fInterface.model.directoryPath + '/' + fInterface.proxyHeaderFile
     }
 
+    def getProxySourceFile(FInterface fInterface) {
+        fInterface.elementName + "Proxy.cpp"
+    }
+
+    def getProxySourcePath(FInterface fInterface) {
+        fInterface.versionPathPrefix + fInterface.model.directoryPath + '/' + fInterface.proxySourceFile
+    }
+
+    /**
+     * In unity build mode, a source file that includes all generated sources and a header that
+     * includes all common headers are generated per package.
+     */
+    def boolean isUnityBuild() {
+        FPreferences::instance.getPreference(PreferenceConstants::P_UNITY_BUILD, "false").equals("true")
+    }
+
+    /**
+     * Generate the compile-time metadata of the interface elements into the interface headers.
+     */
+    def boolean isInterfaceMetadata() {
+        FPreferences::instance.getPreference(PreferenceConstants::P_INTERFACE_METADATA, "false").equals("true")
+    }
+
+    /**
+     * Generate serializedSize() for structs, unions, arrays and maps.
+     */
+    def boolean isSerializedSize() {
+        FPreferences::instance.getPreference(PreferenceConstants::P_SERIALIZED_SIZE, "false").equals("true")
+    }
+
+    /**
+     * Generate a trivially copyable representation (...Data) of the structs whose layout
+     * equals their packed serialized layout.
+     */
+    def boolean isTrivialStructs() {
+        FPreferences::instance.getPreference(PreferenceConstants::P_TRIVIAL_STRUCTS, "false").equals("true")
+    }
+
+    /**
+     * Generate std::pmr containers and strings and allocator-aware constructors for structs (C++17).
+     */
+    def boolean isPmrTypes() {
+        FPreferences::instance.getPreference(PreferenceConstants::P_PMR_TYPES, "false").equals("true")
+    }
+
+    def String getVectorTypeName() {
+        if (pmrTypes) "std::pmr::vector" else "std::vector"
+    }
+
+    /**
+     * The default proxy (Proxy<>) is declared as extern template in the proxy header and
+     * explicitly instantiated once in the proxy source file.
+     */
+    def boolean isExternProxyTemplates() {
+        FPreferences::instance.getPreference(PreferenceConstants::P_EXTERN_PROXY_TEMPLATES, "false").equals("true")
+    }
+
     def getStubDefaultHeaderFile(FInterface fInterface) {
         fInterface.elementName + "Stub" + skeletonNamePostfix + ".hpp"
     }
@@ -1201,6 +1288,26 @@ class FrancaGeneratorExtensions {
         'subscribersFor' + fBroadcast.elementName.toFirstUpper + 'Selective_';
     }
 
+    def getStubAdapterClassSubscriberMutexName(FBroadcast fBroadcast) {
+        'subscribersFor' + fBroadcast.elementName.toFirstUpper + 'SelectiveMutex_';
+    }
+
+    def getStubAdapterClassAddSubscriberMethodName(FBroadcast fBroadcast) {
+        'addSubscriberFor' + fBroadcast.elementName.toFirstUpper + 'Selective';
+    }
+
+    def getStubAdapterClassRemoveSubscriberMethodName(FBroadcast fBroadcast) {
+        'removeSubscriberFor' + fBroadcast.elementName.toFirstUpper + 'Selective';
+    }
+
+    def getStubAdapterClassHasSubscriberMethodName(FBroadcast fBroadcast) {
+        'hasSubscriberFor' + fBroadcast.elementName.toFirstUpper + 'Selective';
+    }
+
+    def getStubAdapterClassSubscriberSnapshotMethodName(FBroadcast fBroadcast) {
+        'getSubscriberSnapshotFor' + fBroadcast.elementName.toFirstUpper + 'Selective';
+    }
+
     def getStubSubscribeSignature(FBroadcast fBroadcast) {
         'const std::shared_ptr<CommonAPI::ClientId> _client, bool &_success'
     }
@@ -1212,7 +1319,7 @@ class FrancaGeneratorExtensions {
             typeName = 'std::shared_ptr< ' + typeName + '>'
 
         if (_element.array) {
-            typeName = 'std::vector< ' + typeName + ' >'
+            typeName = vectorTypeName + '< ' + typeName + ' >'
         }
 
         return typeName
@@ -1388,7 +1495,7 @@ class FrancaGeneratorExtensions {
             case FBasicTypeId::UINT64: "uint64_t"
             case FBasicTypeId::FLOAT: "float"
             case FBasicTypeId::DOUBLE: "double"
-            case FBasicTypeId::STRING: "std::string"
+            case FBasicTypeId::STRING: if (pmrTypes) "std::pmr::string" else "std::string"
             case FBasicTypeId::BYTE_BUFFER: "CommonAPI::ByteBuffer"
             default: throw new IllegalArgumentException("Unsupported basic type: " + fBasicTypeId.getName)
         }
@@ -1505,7 +1612,12 @@ class FrancaGeneratorExtensions {
 
     def private String getElementsTypeStreamSignature(FStructType fStructType,
         PropertyAccessor deploymentAccessor) {
-        var signature = fStructType.elements.map[type.typeStreamSignature(deploymentAccessor, it)].join
+        var signature = fStructType.elements.filter[!fStructType.isPackedBoolean(it) || fStructType.isFirstPackedBoolean(it)].map[
+            if (fStructType.isPackedBoolean(it))
+                fStructType.packedBooleansType.basicTypeStreamSignature
+            else
+                type.typeStreamSignature(deploymentAccessor, it)
+        ].join
 
         if (fStructType.base !== null)
             signature = fStructType.base.getElementsTypeStreamSignature(deploymentAccessor) + signature
@@ -1628,10 +1740,466 @@ class FrancaGeneratorExtensions {
             hasher.putString(fTypeRef.predefined.getName, Charsets::UTF_8);
     }
 
+    /**
+     * The structural fingerprint of an interface covers its elements (including those of the base
+     * interfaces) with their names, kinds, flags and argument types, and the complete structure
+     * of the used types. The names of the interface, its package and its version as well as the
+     * names of the types are not part of the fingerprint, thus equally structured interfaces of
+     * different packages have the same fingerprint. Managed interfaces contribute their own structural
+     * fingerprint, polymorphic structs the structure of all structs derived from them. The elements
+     * are hashed in the order of their names and kinds, derived structs are only taken from the
+     * model of the interface and its (transitive) imports, so neither the order of the declarations
+     * nor other files of the build change the fingerprint.
+     */
+    def int getInterfaceFingerprint(FInterface _interface) {
+        val hasher = Hashing::murmur3_32.newHasher
+        val scope = new HashSet<Resource>()
+        _interface.model?.eResource?.addImportedResources(scope)
+        hasher.putInterfaceFingerprint(_interface, new HashSet<FType>(), new HashSet<FInterface>(), scope)
+        return hasher.hash.asInt
+    }
+
+    /**
+     * Adds the resource and the resources of its (transitive) imports that are loaded into its resource set.
+     */
+    def private void addImportedResources(Resource _resource, Set<Resource> _resources) {
+        if (!_resources.add(_resource))
+            return
+        val resourceSet = _resource.resourceSet
+        for (model : _resource.contents.filter(FModel)) {
+            for (itsImport : model.imports.filter[importURI !== null]) {
+                val imported = if (resourceSet !== null)
+                    resourceSet.getResource(URI.createURI(itsImport.importURI).resolve(_resource.URI), false)
+                if (imported !== null)
+                    imported.addImportedResources(_resources)
+            }
+        }
+    }
+
+    def private void putInterfaceFingerprint(Hasher hasher, FInterface _interface, Set<FType> _stack,
+        Set<FInterface> _interfaces, Set<Resource> _scope) {
+        // an interface that (indirectly) manages itself is only hashed once
+        if (!_interfaces.add(_interface)) {
+            hasher.putString('recursive', Charsets::UTF_8)
+            return
+        }
+        if (_interface.base !== null)
+            hasher.putInterfaceFingerprint(_interface.base, _stack, _interfaces, _scope)
+
+        hasher.putString('FInterface', Charsets::UTF_8)
+        // each element is hashed on its own, the element hashes are added in the order of the
+        // names and kinds of the elements (and of the hashes, for overloaded methods)
+        val elementFingerprints = new TreeMap<String, Integer>()
+        for (itsElement : _interface.elements) {
+            val elementHasher = Hashing::murmur3_32.newHasher
+            val kind = itsElement.eClass.name
+            elementHasher.putString(itsElement.elementName, Charsets::UTF_8)
+            elementHasher.putString(kind, Charsets::UTF_8)
+            if (itsElement instanceof FAttribute) {
+                elementHasher.putBoolean(itsElement.readonly)
+                elementHasher.putBoolean(itsElement.noSubscriptions)
+                elementHasher.putTypedElementFingerprint(itsElement, _stack, _scope)
+            } else if (itsElement instanceof FMethod) {
+                elementHasher.putBoolean(itsElement.fireAndForget)
+                itsElement.inArgs.forEach[elementHasher.putTypedElementFingerprint(it, _stack, _scope)]
+                elementHasher.putString('->', Charsets::UTF_8)
+                itsElement.outArgs.forEach[elementHasher.putTypedElementFingerprint(it, _stack, _scope)]
+                if (itsElement.errorEnum !== null)
+                    elementHasher.putTypeFingerprint(itsElement.errorEnum, _stack, _scope)
+                if (itsElement.errors !== null)
+                    elementHasher.putTypeFingerprint(itsElement.errors, _stack, _scope)
+            } else if (itsElement instanceof FBroadcast) {
+                elementHasher.putBoolean(itsElement.selective)
+                itsElement.outArgs.forEach[elementHasher.putTypedElementFingerprint(it, _stack, _scope)]
+            } else if (itsElement instanceof FConstantDef) {
+                elementHasher.putTypedElementFingerprint(itsElement, _stack, _scope)
+            }
+            val elementFingerprint = elementHasher.hash.asInt
+            elementFingerprints.put(itsElement.elementName + '/' + kind + '/' + String.format("%08X", elementFingerprint),
+                elementFingerprint)
+        }
+        for (elementFingerprint : elementFingerprints.values)
+            hasher.putInt(elementFingerprint)
+        for (itsManaged : _interface.managedInterfaces) {
+            hasher.putString('manages', Charsets::UTF_8)
+            hasher.putInterfaceFingerprint(itsManaged, _stack, _interfaces, _scope)
+        }
+        _interfaces.remove(_interface)
+    }
+
+    def private void putTypedElementFingerprint(Hasher hasher, FTypedElement _element, Set<FType> _stack, Set<Resource> _scope) {
+        hasher.putString(_element.elementName, Charsets::UTF_8)
+        hasher.putBoolean(_element.array)
+        hasher.putTypeRefFingerprint(_element.type, _stack, _scope)
+    }
+
+    def private void putTypeRefFingerprint(Hasher hasher, FTypeRef _typeRef, Set<FType> _stack, Set<Resource> _scope) {
+        if (_typeRef.derived !== null)
+            hasher.putTypeFingerprint(_typeRef.derived, _stack, _scope)
+        else if (_typeRef.interval !== null)
+            hasher.putString('Integer(' + _typeRef.interval.lowerBound + ',' + _typeRef.interval.upperBound + ')',
+                Charsets::UTF_8)
+        else
+            hasher.putString(_typeRef.predefined.getName, Charsets::UTF_8)
+    }
+
+    def private void putTypeFingerprint(Hasher hasher, FType _type, Set<FType> _stack, Set<Resource> _scope) {
+        // a type that (indirectly) contains itself is only hashed once
+        if (!_stack.add(_type)) {
+            hasher.putString('recursive', Charsets::UTF_8)
+            return
+        }
+        hasher.putFTypeFingerprint(_type, _stack, _scope)
+        _stack.remove(_type)
+    }
+
+    def private dispatch void putFTypeFingerprint(Hasher hasher, FStructType _type, Set<FType> _stack, Set<Resource> _scope) {
+        if (_type.base !== null)
+            hasher.putTypeFingerprint(_type.base, _stack, _scope)
+        hasher.putString('FStructType', Charsets::UTF_8)
+        hasher.putBoolean(_type.polymorphic)
+        if (_type.packedBooleans)
+            hasher.putString('PackBooleans', Charsets::UTF_8)
+        _type.elements.forEach[hasher.putTypedElementFingerprint(it, _stack, _scope)]
+        if (_type.polymorphic || _type.base !== null) {
+            // any derived struct of the models in scope may be sent instead of this one;
+            // the order of the derived structs within the model does not matter
+            val derivedFingerprints = _type.derivedFStructTypes.filter[_scope.contains(eResource)].map[derived |
+                val derivedHasher = Hashing::murmur3_32.newHasher
+                derivedHasher.putTypeFingerprint(derived, _stack, _scope)
+                derivedHasher.hash.asInt
+            ].sort
+            for (derivedFingerprint : derivedFingerprints) {
+                hasher.putString('derived', Charsets::UTF_8)
+                hasher.putInt(derivedFingerprint)
+            }
+        }
+    }
+
+    def private dispatch void putFTypeFingerprint(Hasher hasher, FUnionType _type, Set<FType> _stack, Set<Resource> _scope) {
+        if (_type.base !== null)
+            hasher.putTypeFingerprint(_type.base, _stack, _scope)
+        hasher.putString('FUnionType', Charsets::UTF_8)
+        _type.elements.forEach[hasher.putTypedElementFingerprint(it, _stack, _scope)]
+    }
+
+    def private dispatch void putFTypeFingerprint(Hasher hasher, FEnumerationType _type, Set<FType> _stack, Set<Resource> _scope) {
+        if (_type.base !== null)
+            hasher.putTypeFingerprint(_type.base, _stack, _scope)
+        hasher.putString('FEnumerationType', Charsets::UTF_8)
+        _type.enumerators.forEach[
+            hasher.putString(name, Charsets::UTF_8)
+            hasher.putString(String.valueOf(value?.enumeratorValue), Charsets::UTF_8)
+        ]
+    }
+
+    def private dispatch void putFTypeFingerprint(Hasher hasher, FArrayType _type, Set<FType> _stack, Set<Resource> _scope) {
+        hasher.putString('FArrayType', Charsets::UTF_8)
+        hasher.putTypeRefFingerprint(_type.elementType, _stack, _scope)
+    }
+
+    def private dispatch void putFTypeFingerprint(Hasher hasher, FMapType _type, Set<FType> _stack, Set<Resource> _scope) {
+        hasher.putString('FMapType', Charsets::UTF_8)
+        hasher.putTypeRefFingerprint(_type.keyType, _stack, _scope)
+        hasher.putTypeRefFingerprint(_type.valueType, _stack, _scope)
+    }
+
+    def private dispatch void putFTypeFingerprint(Hasher hasher, FTypeDef _type, Set<FType> _stack, Set<Resource> _scope) {
+        hasher.putTypeRefFingerprint(_type.actualType, _stack, _scope)
+    }
+
+    /**
+     * @return the number of bytes of the member values of a struct whose members all have a fixed
+     *         size, or -1 if a member has a variable size. Booleans count one byte, enumerations
+     *         the size of their backing type, alignment and length fields are not included.
+     */
+    def int getPackedSize(FStructType _struct) {
+        if (_struct.hasPolymorphicBase)
+            return -1
+        var int size = 0
+        for (element : _struct.allElements.filter[!_struct.isPackedBoolean(it)]) {
+            val int elementSize = (if (element.array) -1 else element.type.packedSize)
+            if (elementSize < 0)
+                return -1
+            size = size + elementSize
+        }
+        if (_struct.packedBooleans)
+            size = size + _struct.packedBooleansType.packedSize
+        return size
+    }
+
+    def private int getPackedSize(FTypeRef _typeRef) {
+        val derived = _typeRef.derived
+        if (_typeRef.interval !== null)
+            return 4
+        if (derived === null)
+            return _typeRef.predefined.packedSize
+        switch (derived) {
+            FTypeDef: derived.actualType.packedSize
+            FEnumerationType: derived.getBackingType(getAccessor(derived.containingTypeCollection)).packedSize
+            FStructType: derived.packedSize
+            default: -1
+        }
+    }
+
+    /**
+     * @return true if all members of the struct are fixed size integers, floating point values,
+     *         Booleans or enumerations and their natural C++ layout has no padding, i.e. it equals
+     *         the packed serialized layout
+     */
+    def boolean isTriviallyCopyable(FStructType _struct) {
+        if (_struct.hasPolymorphicBase || _struct.allElements.empty || _struct.packedBooleans)
+            return false
+        var int offset = 0
+        var int alignment = 1
+        for (element : _struct.allElements) {
+            val int size = (if (element.array) -1 else element.type.trivialSize)
+            if (size <= 0 || offset % size != 0)
+                return false
+            offset = offset + size
+            alignment = Math.max(alignment, size)
+        }
+        return offset % alignment == 0
+    }
+
+    /**
+     * @return the size of a fixed size primitive or enumeration (also behind typedefs), -1 otherwise.
+     */
+    def int getTrivialSize(FTypeRef _typeRef) {
+        val derived = _typeRef.derived
+        if (_typeRef.interval !== null)
+            return -1
+        if (derived === null)
+            return _typeRef.predefined.packedSize
+        switch (derived) {
+            FTypeDef: derived.actualType.trivialSize
+            FEnumerationType: derived.getBackingType(getAccessor(derived.containingTypeCollection)).packedSize
+            default: -1
+        }
+    }
+
+    /**
+     * @return the enumeration of a type reference (also behind typedefs), null for other types
+     */
+    def FEnumerationType getTrivialEnumeration(FTypeRef _typeRef) {
+        val derived = _typeRef.derived
+        switch (derived) {
+            FTypeDef: derived.actualType.trivialEnumeration
+            FEnumerationType: derived
+            default: null
+        }
+    }
+
+    /**
+     * @return true if the type reference is a Boolean (also behind typedefs)
+     */
+    def boolean isTrivialBoolean(FTypeRef _typeRef) {
+        if (_typeRef.derived instanceof FTypeDef)
+            return (_typeRef.derived as FTypeDef).actualType.trivialBoolean
+        return _typeRef.derived === null && _typeRef.predefined == FBasicTypeId::BOOLEAN
+    }
+
+    /**
+     * @return the C++ type of a fixed size primitive or enumeration in a trivially copyable struct,
+     *         enumerations are represented by their backing type and Booleans by uint8_t, as
+     *         copying a received byte other than 0 or 1 into a bool is undefined
+     */
+    def String getTrivialTypeName(FTypeRef _typeRef) {
+        val enumeration = _typeRef.trivialEnumeration
+        if (enumeration !== null)
+            return enumeration.getBackingType(getAccessor(enumeration.containingTypeCollection)).primitiveTypeName
+        if (_typeRef.trivialBoolean)
+            return 'uint8_t'
+        if (_typeRef.derived instanceof FTypeDef)
+            return (_typeRef.derived as FTypeDef).actualType.trivialTypeName
+        return _typeRef.predefined.primitiveTypeName
+    }
+
+    /**
+     * @return true if the array is deployed with the SoA layout and its elements are non-polymorphic,
+     *         non-empty structs, i.e. a structure of arrays container can be generated for it
+     */
+    def boolean isStructureOfArrays(FArrayType _array) {
+        if (getAccessor(_array.containingTypeCollection).getArrayLayout(_array) != ArrayLayout.SoA)
+            return false
+        val derived = _array.elementType.derived
+        return derived instanceof FStructType
+            && !(derived as FStructType).hasPolymorphicBase && !(derived as FStructType).allElements.empty
+    }
+
+    def private boolean hasPackableBooleans(FStructType _struct) {
+        if (_struct.base !== null || _struct.polymorphic)
+            return false
+        if (!getAccessor(_struct.containingTypeCollection).getPackBooleans(_struct))
+            return false
+        val count = _struct.elements.filter[packableBoolean].size
+        return count >= 2 && count <= 64
+    }
+
+    /**
+     * @return true if the struct is deployed with PackBooleans and PackBooleansOnWire and has two
+     *         to 64 Boolean members, which are then stored and serialized as bits of one unsigned
+     *         integer member
+     */
+    def boolean isPackedBooleans(FStructType _struct) {
+        _struct.hasPackableBooleans
+            && getAccessor(_struct.containingTypeCollection).getPackBooleansOnWire(_struct)
+    }
+
+    /**
+     * @return true if the struct is deployed with PackBooleans only and has two to 64 Boolean
+     *         members. The struct keeps its members, a companion struct stores the Boolean members
+     *         as bits of one unsigned integer and is serialized member by member.
+     */
+    def boolean hasPackedBooleansStruct(FStructType _struct) {
+        _struct.hasPackableBooleans
+            && !getAccessor(_struct.containingTypeCollection).getPackBooleansOnWire(_struct)
+    }
+
+    def String getPackedBooleansStructName(FStructType _struct) {
+        _struct.elementName + "Packed"
+    }
+
+    def boolean isPackableBoolean(FField _element) {
+        !_element.array && _element.type.derived === null && _element.type.interval === null
+            && _element.type.predefined == FBasicTypeId::BOOLEAN
+    }
+
+    def boolean isPackedBoolean(FStructType _struct, FField _element) {
+        _element.packableBoolean && _struct.packedBooleans
+    }
+
+    def boolean isFirstPackedBoolean(FStructType _struct, FField _element) {
+        _struct.packedBooleans && _struct.elements.findFirst[packableBoolean] == _element
+    }
+
+    /**
+     * @return the unsigned integer type whose bits store the packed Boolean members of the struct
+     */
+    def FBasicTypeId getPackedBooleansType(FStructType _struct) {
+        val count = _struct.elements.filter[packableBoolean].size
+        if (count <= 8)
+            return FBasicTypeId::UINT8
+        if (count <= 16)
+            return FBasicTypeId::UINT16
+        if (count <= 32)
+            return FBasicTypeId::UINT32
+        return FBasicTypeId::UINT64
+    }
+
+    /**
+     * @return the mask of the bit that stores a packed Boolean member
+     */
+    def String getPackedBooleanMask(FStructType _struct, FField _element) {
+        val bit = _struct.elements.filter[packableBoolean].toList.indexOf(_element)
+        return "0x" + BigInteger.ONE.shiftLeft(bit).toString(16) + (if (bit >= 32) "ull" else "u")
+    }
+
+    def int getTupleIndex(FStructType _struct, FField _element) {
+        _struct.getTupleIndex(_element, _struct.packedBooleans)
+    }
+
+    /**
+     * @return the index of the member in the values_ tuple of a non-polymorphic struct. If _packed,
+     *         the Boolean members share the index of the unsigned integer that stores them.
+     */
+    def int getTupleIndex(FStructType _struct, FField _element, boolean _packed) {
+        var int index = -1
+        var int packedIndex = -1
+        for (element : _struct.allElements) {
+            if (_packed && element.packableBoolean) {
+                if (packedIndex < 0) {
+                    index = index + 1
+                    packedIndex = index
+                }
+                if (element == _element)
+                    return packedIndex
+            } else {
+                index = index + 1
+                if (element == _element)
+                    return index
+            }
+        }
+        return -1
+    }
+
+    def List<String> getTupleTypeNames(FStructType _struct) {
+        _struct.getTupleTypeNames(_struct.packedBooleans)
+    }
+
+    /**
+     * @return the types of the values_ tuple of a non-polymorphic struct. If _packed, one unsigned
+     *         integer takes the place of the Boolean members.
+     */
+    def List<String> getTupleTypeNames(FStructType _struct, boolean _packed) {
+        val List<String> typeNames = new ArrayList<String>()
+        var boolean hasPackedType = false
+        for (element : _struct.allElements) {
+            if (!_packed || !element.packableBoolean) {
+                typeNames.add(element.getTypeName(_struct, false))
+            } else if (!hasPackedType) {
+                typeNames.add(_struct.packedBooleansType.primitiveTypeName)
+                hasPackedType = true
+            }
+        }
+        return typeNames
+    }
+
+    def private int getPackedSize(FBasicTypeId _type) {
+        switch (_type) {
+            case FBasicTypeId::BOOLEAN: 1
+            case FBasicTypeId::INT8: 1
+            case FBasicTypeId::UINT8: 1
+            case FBasicTypeId::INT16: 2
+            case FBasicTypeId::UINT16: 2
+            case FBasicTypeId::INT32: 4
+            case FBasicTypeId::UINT32: 4
+            case FBasicTypeId::INT64: 8
+            case FBasicTypeId::UINT64: 8
+            case FBasicTypeId::FLOAT: 4
+            case FBasicTypeId::DOUBLE: 8
+            default: -1
+        }
+    }
+
+
+    /**
+     * Index the derived structs of all structs in the resource set. Until the index is cleared,
+     * getDerivedFStructTypes uses it for the structs of this resource set instead of searching
+     * the whole resource set on each call. The index is kept per resource set, as several
+     * builds may run concurrently, each with its own resource set.
+     */
+    def buildDerivedFStructTypesIndex(ResourceSet _resourceSet) {
+        val Map<FStructType, List<FStructType>> index = new HashMap<FStructType, List<FStructType>>()
+        EcoreUtil.resolveAll(_resourceSet)
+        for (resource : new ArrayList<Resource>(_resourceSet.resources)) {
+            for (derived : resource.allContents.toIterable.filter(FStructType)) {
+                if (derived.base !== null) {
+                    var derivedTypes = index.get(derived.base)
+                    if (derivedTypes === null) {
+                        derivedTypes = new ArrayList<FStructType>()
+                        index.put(derived.base, derivedTypes)
+                    }
+                    derivedTypes.add(derived)
+                }
+            }
+        }
+        derivedFStructTypes__.put(_resourceSet, index)
+    }
+
+    def clearDerivedFStructTypesIndex(ResourceSet _resourceSet) {
+        derivedFStructTypes__.remove(_resourceSet)
+    }
 
-    def getDerivedFStructTypes(FStructType fStructType) {
+    def Iterable<FStructType> getDerivedFStructTypes(FStructType fStructType) {
+        val resourceSet = fStructType.eResource?.resourceSet
+        val index = if (resourceSet !== null) derivedFStructTypes__.get(resourceSet)
+        if (index !== null) {
+            val derivedTypes = index.get(fStructType)
+            return if (derivedTypes !== null) derivedTypes else Collections.emptyList
+        }
         return EcoreUtil.UsageCrossReferencer::find(fStructType, fStructType.model.eResource.resourceSet).map[EObject].
-            filter[it instanceof FStructType].map[it as FStructType].filter[base == fStructType]
+            filter[it instanceof FStructType].map[it as FStructType].filter[base == fStructType].toList
     }
 
     def boolean isStructEmpty(FStructType fStructType) {
@@ -1970,6 +2538,175 @@ class FrancaGeneratorExtensions {
         return timeout
     }
 
+    def StubDispatch getStubDispatch(FMethod _method, PropertyAccessor _accessor) {
+        if (_accessor === null)
+            return StubDispatch::Inline
+        return _accessor.getStubDispatch(_method)
+    }
+
+    def boolean isDispatched(FMethod _method, PropertyAccessor _accessor) {
+        return _method.getStubDispatch(_accessor) != StubDispatch::Inline
+    }
+
+    def boolean hasDispatchedMethods(FInterface _interface, PropertyAccessor _accessor) {
+        return !_interface.methods.filter[isDispatched(_accessor)].empty
+    }
+
+    def getStubDispatcherClassName(FInterface fInterface) {
+        fInterface.elementName + 'StubDispatcher'
+    }
+
+    def getStubDispatchedMethodName(FMethod fMethod) {
+        fMethod.elementName + 'Dispatched'
+    }
+
+    def int getStubQueueLimit(FInterface _interface, PropertyAccessor _accessor) {
+        if (_accessor === null)
+            return 0
+        val limit = _accessor.getStubQueueLimit(_interface)
+        if (limit === null || limit < 0)
+            return 0
+        return limit
+    }
+
+    def FBroadcast getOverloadError(FMethod _method, PropertyAccessor _accessor) {
+        if (_accessor === null || !_method.isDispatched(_accessor) || _method.isFireAndForget)
+            return null
+        val errorName = _accessor.getOverloadError(_method)
+        if (errorName === null)
+            return null
+        return (_method.eContainer as FInterface).broadcasts.findFirst[
+            elementName == errorName && isErrorType(_method, _accessor)
+        ]
+    }
+
+    def generateOverloadErrorReply(FMethod fMethod, FBroadcast fBroadcast, PropertyAccessor deploymentAccessor) {
+        var arguments = '_call'
+        if (!fBroadcast.errorArgs(deploymentAccessor).empty)
+            arguments = arguments + ', ' + fBroadcast.errorArgs(deploymentAccessor).map[getTypeName(fBroadcast, true) + '()'].join(', ')
+        return '_' + fMethod.elementName + fBroadcast.elementName.toFirstUpper + 'Reply(' + arguments + ')'
+    }
+
+    def boolean isCacheable(FMethod _method, PropertyAccessor _accessor) {
+        if (_accessor === null || _method.isFireAndForget || _method.isStreamed(_accessor))
+            return false
+        val cacheable = _accessor.getCacheable(_method)
+        return cacheable !== null && cacheable
+    }
+
+    def int getCacheSize(FMethod _method, PropertyAccessor _accessor) {
+        val size = _accessor.getCacheSize(_method)
+        if (size === null || size < 0)
+            return 0
+        return size
+    }
+
+    def int getReplyChunkSize(FMethod _method, PropertyAccessor _accessor) {
+        if (_accessor === null)
+            return 0
+        val size = _accessor.getReplyChunkSize(_method)
+        if (size === null || size < 0)
+            return 0
+        return size
+    }
+
+    /**
+     * A method streams its reply if a ReplyChunkSize is deployed, its only output argument is an
+     * array and its last input argument is the UInt64 chunk offset.
+     */
+    def boolean isStreamed(FMethod _method, PropertyAccessor _accessor) {
+        if (_method.getReplyChunkSize(_accessor) == 0 || _method.isFireAndForget || _method.hasError)
+            return false
+        if (_method.outArgs.size != 1 || _method.inArgs.empty)
+            return false
+        val out = _method.outArgs.get(0)
+        if (!out.array && !(out.type.derived instanceof FArrayType))
+            return false
+        val offset = _method.inArgs.last
+        return !offset.array && offset.type.derived === null && offset.type.predefined == FBasicTypeId::UINT64
+    }
+
+    def getStreamedInArgs(FMethod _method) {
+        return _method.inArgs.subList(0, _method.inArgs.size - 1)
+    }
+
+    def getStreamOffsetArg(FMethod _method) {
+        return _method.inArgs.last
+    }
+
+    def getProxyStreamMethodName(FMethod fMethod) {
+        fMethod.elementName + 'Stream'
+    }
+
+    def getProxyStreamChunkCallbackName(FMethod fMethod) {
+        fMethod.elementName + 'ChunkCallback'
+    }
+
+    def getProxyStreamFinishedCallbackName(FMethod fMethod) {
+        fMethod.elementName + 'FinishedCallback'
+    }
+
+    def getStubStreamMethodName(FMethod fMethod) {
+        fMethod.elementName + 'Stream'
+    }
+
+    def getStubChunkWriterClassName(String _replyName) {
+        _replyName.toFirstUpper + 'ChunkWriter'
+    }
+
+    def getStubUncachedMethodName(FMethod fMethod) {
+        fMethod.elementName + 'Uncached'
+    }
+
+    def getStubInvalidateCacheMethodName(String _replyName) {
+        'invalidate' + _replyName.toFirstUpper + 'Cache'
+    }
+
+    def getStubCacheStatisticsMethodName(String _replyName) {
+        'get' + _replyName.toFirstUpper + 'CacheStatistics'
+    }
+
+    def getStubCacheSizeMethodName(String _replyName) {
+        'set' + _replyName.toFirstUpper + 'CacheSize'
+    }
+
+    def List<String> getStubReplyTypes(FMethod fMethod) {
+        val types = new ArrayList<String>
+        if (fMethod.hasError)
+            types.add(fMethod.getErrorNameReference(fMethod.eContainer))
+        types.addAll(fMethod.outArgs.map[getTypeName(fMethod, true)])
+        return types
+    }
+
+    def List<String> getStubReplyArguments(FMethod fMethod) {
+        val arguments = new ArrayList<String>
+        if (fMethod.hasError)
+            arguments.add('_error')
+        arguments.addAll(fMethod.outArgs.map['_' + elementName])
+        return arguments
+    }
+
+    def generateOverloadedStubArguments(FMethod fMethod, LinkedHashMap<String, Boolean> replies) {
+        var arguments = '_client'
+
+        if (!fMethod.isFireAndForget && replies.containsValue(true))
+            arguments = arguments + ', _call'
+
+        if (!fMethod.inArgs.empty)
+            arguments = arguments + ', ' + fMethod.inArgs.map['_' + elementName].join(', ')
+
+        if (!fMethod.isFireAndForget) {
+            for (Map.Entry<String, Boolean> entry : replies.entrySet) {
+                if (entry.value) {
+                    arguments = arguments + ', _' + entry.key + 'Reply'
+                } else {
+                    arguments = arguments + ', _reply'
+                }
+            }
+        }
+        return arguments
+    }
+
     def boolean isTheSameVersion(FVersion _mine, FVersion _other) {
         return ((_mine === null && _other === null) ||
                 (_mine !== null && _other !== null &&
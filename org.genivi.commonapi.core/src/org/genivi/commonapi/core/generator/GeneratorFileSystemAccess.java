@@ -6,16 +6,22 @@ package org.genivi.commonapi.core.generator;
 
 import java.util.HashSet;
 import java.util.Set;
+import java.util.TreeSet;
 
 import org.eclipse.xtext.generator.JavaIoFileSystemAccess;
+import org.eclipse.xtext.util.RuntimeIOException;
 
 
 /**
  * This class adds the feature to printout the generated files to the JavaIoFileSystemAccess implementation.
+ * Files whose contents did not change are not rewritten to keep their modification time.
  */
 public class GeneratorFileSystemAccess extends JavaIoFileSystemAccess {
 
 	private Set<String> fileList = new HashSet<String>();
+	private Set<String> recordedFileList = new HashSet<String>();
+	private int writtenCount = 0;
+	private int skippedCount = 0;
 	
 	public GeneratorFileSystemAccess() {
 		super();
@@ -23,34 +29,90 @@ public class GeneratorFileSystemAccess extends JavaIoFileSystemAccess {
 	
 	public void clearFileList() {
 		fileList.clear();
+		recordedFileList.clear();
+		writtenCount = 0;
+		skippedCount = 0;
+	}
+
+	/**
+	 * @return the number of files written since the last call of clearFileList
+	 */
+	public int getWrittenCount() {
+		return writtenCount;
+	}
+
+	/**
+	 * @return the number of files that were not written because their contents did not change
+	 */
+	public int getSkippedCount() {
+		return skippedCount;
 	}
 	
 	/**
-	 * Call the base class method and store the filename in the list
+	 * Generate the file into the default output configuration
 	 * @param fileName using '/' as file separator
 	 * @param contents the to-be-written contents.
 	 */	
 	public void generateFile(String fileName, CharSequence contents) {
-		// do not generate a file if the contents is empty (feature: suppress code generation)
-		if(contents.length() > 0) {
-			super.generateFile(fileName, contents);
-		}
-		addFilePath(fileName, "");
+		generateFile(fileName, DEFAULT_OUTPUT, contents);
 	}
 	
 	/**
-	 * Call the base class method and store the filename in the list
+	 * Call the base class method if the contents differ from the existing file and store the filename in the list
 	 * @param fileName using '/' as file separator
 	 * @param outputConfigurationName the name of the output configuration
 	 * @param contents the to-be-written contents.
 	 */
 	public void generateFile(String fileName, String outputConfigurationName, CharSequence contents) {
+		// do not generate a file if the contents is empty (feature: suppress code generation)
 		if(contents.length() > 0) {
-			super.generateFile(fileName, outputConfigurationName, contents);
+			if(isUnchanged(fileName, outputConfigurationName, contents)) {
+				skippedCount++;
+			} else {
+				super.generateFile(fileName, outputConfigurationName, contents);
+				writtenCount++;
+			}
 		}
 		addFilePath(fileName, outputConfigurationName);
 	}
+
+	/**
+	 * Compare the contents with the file that is already stored in the output configuration.
+	 * The contents are post processed (e.g. line delimiters) the same way as they would be written.
+	 * @return true if the file exists and has the same contents
+	 */
+	private boolean isUnchanged(String fileName, String outputConfigurationName, CharSequence contents) {
+		try {
+			CharSequence existing = readTextFile(fileName, outputConfigurationName);
+			CharSequence processed = postProcess(fileName, outputConfigurationName, contents);
+			return existing.toString().equals(processed.toString());
+		} catch (RuntimeIOException e) {
+			// the file does not exist (yet) or cannot be read
+			return false;
+		}
+	}
 	
+	/**
+	 * Start recording the generated files, e.g. the files of a single input file
+	 */
+	public void startRecording() {
+		recordedFileList.clear();
+	}
+
+	/**
+	 * @return the paths of the files generated since the last call of startRecording
+	 */
+	public Set<String> getRecordedFileList() {
+		return new TreeSet<String>(recordedFileList);
+	}
+
+	/**
+	 * @return the paths of the files generated since the last call of clearFileList
+	 */
+	public Set<String> getFileList() {
+		return new TreeSet<String>(fileList);
+	}
+
 	public void dumpGeneratedFiles() {
 		for(String name : fileList) {
 			System.out.println(name);
@@ -65,6 +127,7 @@ public class GeneratorFileSystemAccess extends JavaIoFileSystemAccess {
 		if(!dirName.endsWith("/")) {
 			dirName += "/";
 		}
-		fileList.add(dirName + fileName);		
+		fileList.add(dirName + fileName);
+		recordedFileList.add(dirName + fileName);		
 	}
 }
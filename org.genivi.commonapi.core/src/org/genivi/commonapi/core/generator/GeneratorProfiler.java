@@ -0,0 +1,185 @@
+/* Copyright (C) 2020 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+   This Source Code Form is subject to the terms of the Mozilla Public
+   License, v. 2.0. If a copy of the MPL was not distributed with this
+   file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+package org.genivi.commonapi.core.generator;
+
+import java.lang.management.ManagementFactory;
+import java.lang.reflect.Method;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+
+/**
+ * Records the wall time and the allocated memory of the generator phases
+ * (parsing, loading, validation, generation) and of the generated artifacts
+ * (proxy, stub, skeleton, common). The profiler is disabled by default, then
+ * start and stop do nothing.
+ *
+ * The allocated memory is the memory allocated by the measuring thread. It is
+ * -1 if the Java VM does not provide it.
+ */
+public class GeneratorProfiler {
+
+	public static final String PHASE = "phase";
+	public static final String ARTIFACT = "artifact";
+
+	public static final String PARSING = "parsing";
+	public static final String VALIDATION = "validation";
+	public static final String LOADING = "loading";
+	public static final String GENERATION = "generation";
+
+	public static final String PROXY = "proxy";
+	public static final String STUB = "stub";
+	public static final String SKELETON = "skeleton";
+	public static final String COMMON = "common";
+
+	/**
+	 * A single measurement. The subject names the measured element, e.g. the
+	 * interface of an artifact.
+	 */
+	public static class Measurement {
+		private final String category;
+		private final String name;
+		private final String subject;
+		private final String file;
+		private final long startTime;
+		private final long startBytes;
+		private long duration = -1;
+		private long allocatedBytes = -1;
+
+		private Measurement(String category, String name, String subject, String file) {
+			this.category = category;
+			this.name = name;
+			this.subject = subject;
+			this.file = file;
+			this.startBytes = readThreadAllocatedBytes();
+			this.startTime = System.nanoTime();
+		}
+
+		public String getCategory() {
+			return category;
+		}
+
+		public String getName() {
+			return name;
+		}
+
+		public String getSubject() {
+			return subject;
+		}
+
+		/**
+		 * @return the input file that was processed when the measurement started
+		 */
+		public String getFile() {
+			return file;
+		}
+
+		/**
+		 * @return the wall time in nanoseconds
+		 */
+		public long getDuration() {
+			return duration;
+		}
+
+		/**
+		 * @return the allocated memory in bytes or -1 if it is not available
+		 */
+		public long getAllocatedBytes() {
+			return allocatedBytes;
+		}
+	}
+
+	private static volatile boolean isEnabled = false;
+	private static volatile String currentFile = null;
+	private static List<Measurement> measurements = Collections.synchronizedList(new ArrayList<Measurement>());
+
+	// com.sun.management.ThreadMXBean is not available on all Java VMs, it is accessed by reflection
+	private static Object threadBean = null;
+	private static Method allocatedBytesMethod = null;
+
+	static {
+		try {
+			threadBean = ManagementFactory.getThreadMXBean();
+			allocatedBytesMethod = Class.forName("com.sun.management.ThreadMXBean")
+					.getMethod("getThreadAllocatedBytes", long.class);
+		} catch (Exception e) {
+			allocatedBytesMethod = null;
+		}
+	}
+
+	public static void enable(boolean enabled) {
+		isEnabled = enabled;
+	}
+
+	public static boolean isEnabled() {
+		return isEnabled;
+	}
+
+	/**
+	 * Set the input file the following measurements belong to
+	 */
+	public static void setCurrentFile(String file) {
+		currentFile = file;
+	}
+
+	/**
+	 * Start a measurement
+	 *
+	 * @return the started measurement or null if the profiler is disabled
+	 */
+	public static Measurement start(String category, String name, String subject) {
+		if (!isEnabled) {
+			return null;
+		}
+		return new Measurement(category, name, subject, currentFile);
+	}
+
+	public static Measurement start(String category, String name) {
+		return start(category, name, null);
+	}
+
+	/**
+	 * Stop the measurement and record it. Does nothing for null.
+	 */
+	public static void stop(Measurement measurement) {
+		if (measurement == null) {
+			return;
+		}
+		measurement.duration = System.nanoTime() - measurement.startTime;
+		long bytes = readThreadAllocatedBytes();
+		if (bytes >= 0 && measurement.startBytes >= 0) {
+			measurement.allocatedBytes = bytes - measurement.startBytes;
+		}
+		measurements.add(measurement);
+	}
+
+	/**
+	 * @return a copy of the recorded measurements
+	 */
+	public static List<Measurement> getMeasurements() {
+		synchronized (measurements) {
+			return new ArrayList<Measurement>(measurements);
+		}
+	}
+
+	public static void clear() {
+		measurements.clear();
+		currentFile = null;
+	}
+
+	/**
+	 * @return the memory allocated by the current thread so far or -1 if it is not available
+	 */
+	private static long readThreadAllocatedBytes() {
+		if (allocatedBytesMethod == null) {
+			return -1;
+		}
+		try {
+			return (Long) allocatedBytesMethod.invoke(threadBean, Thread.currentThread().getId());
+		} catch (Exception e) {
+			return -1;
+		}
+	}
+}
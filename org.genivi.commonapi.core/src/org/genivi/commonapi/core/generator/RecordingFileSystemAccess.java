@@ -0,0 +1,57 @@
+/* Copyright (C) 2020 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+   This Source Code Form is subject to the terms of the Mozilla Public
+   License, v. 2.0. If a copy of the MPL was not distributed with this
+   file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+package org.genivi.commonapi.core.generator;
+
+import java.util.ArrayList;
+import java.util.List;
+
+import org.eclipse.xtext.generator.IFileSystemAccess;
+
+
+/**
+ * This class records the files generated through a file system access, e.g. the files of a model.
+ * If the model is not generated again for another input file, the recorded files can be reported
+ * as outputs of that input file as well.
+ */
+public class RecordingFileSystemAccess implements IFileSystemAccess {
+
+	private final IFileSystemAccess access;
+	private final List<String[]> files = new ArrayList<String[]>();
+
+	public RecordingFileSystemAccess(IFileSystemAccess access) {
+		this.access = access;
+	}
+
+	@Override
+	public void generateFile(String fileName, CharSequence contents) {
+		generateFile(fileName, DEFAULT_OUTPUT, contents);
+	}
+
+	@Override
+	public void generateFile(String fileName, String outputConfigurationName, CharSequence contents) {
+		access.generateFile(fileName, outputConfigurationName, contents);
+		synchronized (files) {
+			files.add(new String[] { fileName, outputConfigurationName });
+		}
+	}
+
+	@Override
+	public void deleteFile(String fileName) {
+		access.deleteFile(fileName);
+	}
+
+	/**
+	 * Add the recorded files to the file list of the given file system access without writing them again.
+	 * The file names are relative to the output configurations, so the target must use the same
+	 * output directories as the file system access the files were written to.
+	 */
+	public void replay(GeneratorFileSystemAccess target) {
+		synchronized (files) {
+			for (String[] file : files) {
+				target.addFilePath(file[0], file[1]);
+			}
+		}
+	}
+}
@@ -0,0 +1,44 @@
+/* Copyright (C) 2015-2020 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+   This Source Code Form is subject to the terms of the Mozilla Public
+   License, v. 2.0. If a copy of the MPL was not distributed with this
+   file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+package org.genivi.commonapi.core.generator;
+
+import org.eclipse.xtext.generator.IFileSystemAccess;
+
+
+/**
+ * This class serializes the access to a file system access that is shared by several generator threads.
+ * The contents are rendered by the calling thread, only writing the files is done one at a time.
+ */
+public class SynchronizedFileSystemAccess implements IFileSystemAccess {
+
+	private final IFileSystemAccess access;
+
+	public SynchronizedFileSystemAccess(IFileSystemAccess access) {
+		this.access = access;
+	}
+
+	@Override
+	public void generateFile(String fileName, CharSequence contents) {
+		String itsContents = contents.toString();
+		synchronized (access) {
+			access.generateFile(fileName, itsContents);
+		}
+	}
+
+	@Override
+	public void generateFile(String fileName, String outputConfigurationName, CharSequence contents) {
+		String itsContents = contents.toString();
+		synchronized (access) {
+			access.generateFile(fileName, outputConfigurationName, itsContents);
+		}
+	}
+
+	@Override
+	public void deleteFile(String fileName) {
+		synchronized (access) {
+			access.deleteFile(fileName);
+		}
+	}
+}
@@ -0,0 +1,144 @@
+/* Copyright (C) 2020 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+   This Source Code Form is subject to the terms of the Mozilla Public
+   License, v. 2.0. If a copy of the MPL was not distributed with this
+   file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+package org.genivi.commonapi.core.generator;
+
+import java.util.ArrayList;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+import java.util.TreeMap;
+import java.util.TreeSet;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+import org.eclipse.xtext.generator.IFileSystemAccess;
+
+/**
+ * Collects the generated sources and common headers per Franca package for the
+ * unity build files. The files of a package are recorded by the file system
+ * access returned by wrap. The collector may be shared by several generator
+ * threads.
+ */
+public class UnityBuildCollector {
+
+	private static final Pattern INCLUDE_PATTERN = Pattern.compile("^\\s*#include\\s*[<\"]([^>\"]+)[>\"]",
+			Pattern.MULTILINE);
+
+	private Map<String, Set<String>> sources = new TreeMap<String, Set<String>>();
+	// package -> common header -> included files
+	private Map<String, Map<String, Set<String>>> headers = new TreeMap<String, Map<String, Set<String>>>();
+	private Set<String> touchedPackages = new TreeSet<String>();
+
+	/**
+	 * @return a file system access that writes to the given access and records
+	 *         the generated files of the package
+	 */
+	public IFileSystemAccess wrap(final String packageName, final IFileSystemAccess access) {
+		synchronized (this) {
+			touchedPackages.add(packageName);
+		}
+		return new IFileSystemAccess() {
+			@Override
+			public void generateFile(String fileName, CharSequence contents) {
+				access.generateFile(fileName, contents);
+				record(packageName, fileName, DEFAULT_OUTPUT, contents);
+			}
+
+			@Override
+			public void generateFile(String fileName, String outputConfigurationName, CharSequence contents) {
+				access.generateFile(fileName, outputConfigurationName, contents);
+				record(packageName, fileName, outputConfigurationName, contents);
+			}
+
+			@Override
+			public void deleteFile(String fileName) {
+				access.deleteFile(fileName);
+			}
+		};
+	}
+
+	/**
+	 * @return the packages that were recorded since the last call and forget
+	 *         them
+	 */
+	public synchronized Set<String> takeTouchedPackages() {
+		Set<String> packages = touchedPackages;
+		touchedPackages = new TreeSet<String>();
+		return packages;
+	}
+
+	/**
+	 * @return the generated sources of the package, sorted by path
+	 */
+	public synchronized List<String> getSources(String packageName) {
+		Set<String> packageSources = sources.get(packageName);
+		return new ArrayList<String>(packageSources != null ? packageSources : new TreeSet<String>());
+	}
+
+	/**
+	 * @return the common headers of the package, each header after the headers
+	 *         of the package it includes
+	 */
+	public synchronized List<String> getHeaders(String packageName) {
+		List<String> sortedHeaders = new ArrayList<String>();
+		Map<String, Set<String>> packageHeaders = headers.get(packageName);
+		if (packageHeaders != null) {
+			Set<String> visited = new HashSet<String>();
+			for (String header : packageHeaders.keySet()) {
+				addSorted(header, packageHeaders, visited, sortedHeaders);
+			}
+		}
+		return sortedHeaders;
+	}
+
+	private void addSorted(String header, Map<String, Set<String>> packageHeaders, Set<String> visited,
+			List<String> sortedHeaders) {
+		if (!visited.add(header)) {
+			return;
+		}
+		for (String include : packageHeaders.get(header)) {
+			if (packageHeaders.containsKey(include)) {
+				addSorted(include, packageHeaders, visited, sortedHeaders);
+			}
+		}
+		sortedHeaders.add(header);
+	}
+
+	private synchronized void record(String packageName, String fileName, String outputConfigurationName,
+			CharSequence contents) {
+		// suppressed files are not written
+		if (contents.length() == 0) {
+			return;
+		}
+		if (fileName.endsWith(".cpp")) {
+			Set<String> packageSources = sources.get(packageName);
+			if (packageSources == null) {
+				packageSources = new TreeSet<String>();
+				sources.put(packageName, packageSources);
+			}
+			packageSources.add(fileName);
+		} else if (fileName.endsWith(".hpp") && IFileSystemAccess.DEFAULT_OUTPUT.equals(outputConfigurationName)) {
+			Map<String, Set<String>> packageHeaders = headers.get(packageName);
+			if (packageHeaders == null) {
+				packageHeaders = new TreeMap<String, Set<String>>();
+				headers.put(packageName, packageHeaders);
+			}
+			packageHeaders.put(fileName, getIncludes(fileName, contents));
+		}
+	}
+
+	private static Set<String> getIncludes(String fileName, CharSequence contents) {
+		String directory = (fileName.lastIndexOf('/') >= 0 ? fileName.substring(0, fileName.lastIndexOf('/') + 1) : "");
+		Set<String> includes = new TreeSet<String>();
+		Matcher matcher = INCLUDE_PATTERN.matcher(contents);
+		while (matcher.find()) {
+			// quoted includes may be relative to the including file
+			includes.add(matcher.group(1));
+			includes.add(directory + matcher.group(1));
+		}
+		return includes;
+	}
+}
@@ -5,6 +5,7 @@
 package org.genivi.commonapi.core.preferences;
 
 
+import java.util.Collections;
 import java.util.HashMap;
 import java.util.Map;
 import java.io.File;
@@ -24,15 +25,20 @@ public class FPreferences {
 	}
 
 	private FPreferences() {
-        preferences = new HashMap<String, String>();
+        // the generator reads the preferences from several threads
+        preferences = Collections.synchronizedMap(new HashMap<String, String>());
         clidefPreferences();
     }
 
+    /**
+     * Remove all preference values and apply the defaults
+     */
     public void resetPreferences(){
         preferences.clear();
+        clidefPreferences();
     }
 
-    public static FPreferences getInstance() {
+    public static synchronized FPreferences getInstance() {
         if (instance == null) {
             instance = new FPreferences();
         }
@@ -95,12 +101,37 @@ public class FPreferences {
         if (!preferences.containsKey(PreferenceConstants.P_GENERATE_SYNC_CALLS)) {
             preferences.put(PreferenceConstants.P_GENERATE_SYNC_CALLS, "true");    
         }
+        if (!preferences.containsKey(PreferenceConstants.P_JOBS)) {
+            preferences.put(PreferenceConstants.P_JOBS, PreferenceConstants.DEFAULT_JOBS);
+        }
+        if (!preferences.containsKey(PreferenceConstants.P_LEAN_HEADERS)) {
+            preferences.put(PreferenceConstants.P_LEAN_HEADERS, "false");
+        }
+        if (!preferences.containsKey(PreferenceConstants.P_EXTERN_PROXY_TEMPLATES)) {
+            preferences.put(PreferenceConstants.P_EXTERN_PROXY_TEMPLATES, "false");
+        }
+        if (!preferences.containsKey(PreferenceConstants.P_UNITY_BUILD)) {
+            preferences.put(PreferenceConstants.P_UNITY_BUILD, "false");
+        }
+        if (!preferences.containsKey(PreferenceConstants.P_INTERFACE_METADATA)) {
+            preferences.put(PreferenceConstants.P_INTERFACE_METADATA, "false");
+        }
+        if (!preferences.containsKey(PreferenceConstants.P_SERIALIZED_SIZE)) {
+            preferences.put(PreferenceConstants.P_SERIALIZED_SIZE, "false");
+        }
+        if (!preferences.containsKey(PreferenceConstants.P_TRIVIAL_STRUCTS)) {
+            preferences.put(PreferenceConstants.P_TRIVIAL_STRUCTS, "false");
+        }
+        if (!preferences.containsKey(PreferenceConstants.P_PMR_TYPES)) {
+            preferences.put(PreferenceConstants.P_PMR_TYPES, "false");
+        }
     }
 
     public String getPreference(String preferencename, String defaultValue) {
     	
-    	if (preferences.containsKey(preferencename)) {
-    		return preferences.get(preferencename);
+    	String value = preferences.get(preferencename);
+    	if (value != null || preferences.containsKey(preferencename)) {
+    		return value;
     	}
     	System.err.println("Unknown preference " + preferencename);
         return "";
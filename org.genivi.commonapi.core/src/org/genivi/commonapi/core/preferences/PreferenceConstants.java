@@ -31,6 +31,14 @@ public interface PreferenceConstants
 	public static final String P_GENERATE_CODE    		= "generateCode";
 	public static final String P_GENERATE_DEPENDENCIES 	= "generateDependencies";
 	public static final String P_GENERATE_SYNC_CALLS 	= "generateSyncCalls";
+	public static final String P_JOBS 					= "jobs";
+	public static final String P_LEAN_HEADERS 			= "leanHeaders";
+	public static final String P_EXTERN_PROXY_TEMPLATES = "externProxyTemplates";
+	public static final String P_UNITY_BUILD 			= "unityBuild";
+	public static final String P_INTERFACE_METADATA 	= "interfaceMetadata";
+	public static final String P_SERIALIZED_SIZE 		= "serializedSize";
+	public static final String P_TRIVIAL_STRUCTS 		= "trivialStructs";
+	public static final String P_PMR_TYPES 				= "pmrTypes";
     public static final String P_ENABLE_CORE_VALIDATOR 	= "enableCoreValidator";
 	public static final String P_ENABLE_CORE_DEPLOYMENT_VALIDATOR  = "enableCoreDeploymentValidator";
     
@@ -42,5 +50,6 @@ public interface PreferenceConstants
                                                    + "If a copy of the MPL was not distributed with this file, You can obtain one at\n"
                                                    + "http://mozilla.org/MPL/2.0/.";
 	public static final String DEFAULT_SKELETONPOSTFIX = "Default";
+	public static final String DEFAULT_JOBS       = "1";
 	public static final String NO_CODE            = "";
 }
@@ -53,8 +53,16 @@ public class CommandlineValidator {
 	private ValidateElements validateElements = new ValidateElements();
 
 	public CommandlineValidator(ValidationMessageAcceptor cliMessageAcceptor) {
+		this(cliMessageAcceptor, new ResourceSetImpl());
+	}
+
+	/**
+	 * @param resourceSet the resource set to load the imported files, it may be shared
+	 *                    by several validators to parse each file only once
+	 */
+	public CommandlineValidator(ValidationMessageAcceptor cliMessageAcceptor, ResourceSet resourceSet) {
 		this.cliMessageAcceptor = cliMessageAcceptor;
-		resourceSet = new ResourceSetImpl();
+		this.resourceSet = resourceSet;
 		ignoreList = new ArrayList<String>();
 		ignoreMessageList = new ArrayList<String>();
 		ignoreMessageList.add("Duplicate element type");
@@ -36,6 +36,8 @@ import org.franca.deploymodel.dsl.fDeploy.FDGeneric
 import org.franca.deploymodel.dsl.fDeploy.FDEnumerator
 import java.util.HashMap
 import org.eclipse.emf.common.util.BasicDiagnostic
+import org.franca.deploymodel.core.FDeployedInterface
+import org.genivi.commonapi.core.deployment.PropertyAccessor
 
 class DeploymentValidator {
     var BasicDiagnostic diagnostics
@@ -53,6 +55,7 @@ class DeploymentValidator {
 			addModel(fdepl)
         }
         validateEnumSizeDeployments
+        validateOverloadErrorDeployments
     }
     def private addModel(FDModel fdepl) {
     	var deplFileName = fdepl.eResource.URI.lastSegment
@@ -205,6 +208,32 @@ class DeploymentValidator {
 
     }
 
+    private def validateOverloadErrorDeployments() {
+        for (fdInterface : fdInterfaces) {
+            val accessor = new PropertyAccessor(new FDeployedInterface(fdInterface))
+            for (fdMethod : fdInterface.methods) {
+                val propOverloadError = fdMethod.properties?.items?.findFirst[decl.name == "OverloadError"]
+                val method = fdMethod.target
+                val errorName = if (propOverloadError !== null) accessor.getOverloadError(method)
+                if (errorName !== null) {
+                    val broadcast = fdInterface.target.broadcasts.findFirst[name == errorName]
+                    val errors = accessor.getErrors(method)
+                    var String message = null
+                    if (broadcast === null)
+                        message = "OverloadError \"" + errorName + "\" of method \"" + method.name + "\" is not a broadcast of interface \"" + fdInterface.target.name + "\""
+                    else if (accessor.getBroadcastType(broadcast) != PropertyAccessor.BroadcastType.error)
+                        message = "OverloadError \"" + errorName + "\" of method \"" + method.name + "\" is not an error broadcast (BroadcastType = error)"
+                    else if (errors === null || !errors.contains(errorName))
+                        message = "OverloadError \"" + errorName + "\" is not contained in the Errors of method \"" + method.name + "\""
+                    if (message !== null) {
+                        var diag = new FeatureBasedDiagnostic(Diagnostic.ERROR, message, propOverloadError, null, -1, null, null)
+                        diagnostics.add(diag)
+                    }
+                }
+            }
+        }
+    }
+
     private def getMaximumEnumerationValue(FEnumerationType _enumeration) {
         var maximum = maxEnumValues.get(_enumeration)
         if (maximum === null) {